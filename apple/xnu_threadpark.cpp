@@ -1,4 +1,8 @@
 #include "threadpark.h"
+#include "threadpark_cancel.h"
+#include "threadpark_internal.h"
+#include "threadpark_numa.h"
+#include "threadpark_registry.h"
 
 #include <mutex>
 #include <iostream>
@@ -11,14 +15,31 @@ struct tpark_handle_t {
     ///  - 1 indicates "parked" (thread should block until changed),
     ///  - 0 indicates "not parked" (thread can proceed).
     std::atomic<uint32_t> state{0};
+
+    /// Cancellation token the handle is associated with, if any
+    tpark_cancel_link_t cancel;
+
+    /// NUMA node and origin of the handle's memory
+    tpark_numa_placement_t numa;
+
+    TPARK_REGISTRY_ENTRY
 };
 
-tpark_handle_t *tparkCreateHandle() {
-    return new tpark_handle_t();
+tpark_cancel_link_t *tpark_cancel_link(tpark_handle_t *handle) { return &handle->cancel; }
+
+TPARK_REGISTRY_ENTRY_ACCESSOR
+
+tpark_handle_t *tparkCreateHandle() { return tparkCreateHandleOnNode(TPARK_NODE_ANY); }
+
+tpark_handle_t *tparkCreateHandleOnNode(const int node) {
+    auto *handle = tpark_numa_new<tpark_handle_t>(node);
+    TPARK_REGISTRY_ADD(handle);
+    return handle;
 }
 
-void tparkWait(tpark_handle_t *handle, const bool unlocked) {
+tpark_wait_result_t tparkWait(tpark_handle_t *handle, const bool unlocked) {
     if (!unlocked) {
+        TPARK_REGISTRY_ON_PARK(handle);
         // Set the state to 1 to indicate we want to park
         handle->state.store(1, std::memory_order_seq_cst);
     }
@@ -26,6 +47,11 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
     // __ulock_wait(UL_COMPARE_AND_WAIT, &addr, expected_val, timeout)
     // blocks until 'state' != expected_val (or an error/spurious wake occurs).
     while (true) {
+        // Checked after setting the park bit, so that a concurrent tparkCancel either sees us parked or is seen here
+        if (tpark_cancel_requested(&handle->cancel)) {
+            tparkEndPark(handle);
+            return TPARK_WAIT_CANCELLED;
+        }
         const int rc = __ulock_wait(UL_COMPARE_AND_WAIT,
                                     &handle->state,
                                     1, // compare value
@@ -33,8 +59,8 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
         );
         if (rc == 0) {
             // check for spurious wakeups
-            if (handle->state.load(std::memory_order_seq_cst) != 1) {
-                return;
+            if (handle->state.load(std::memory_order_acquire) != 1) {
+                return tpark_cancel_wait_result(&handle->cancel);
             }
         }
         if (rc < 0) {
@@ -44,8 +70,8 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
                 continue;
             } else if (errno == EBUSY) {
                 // check for spurious wakeups
-                if (handle->state.load(std::memory_order_seq_cst) != 1) {
-                    return;
+                if (handle->state.load(std::memory_order_acquire) != 1) {
+                    return tpark_cancel_wait_result(&handle->cancel);
                 }
             } else {
                 std::cerr << "Unexpected error in tparkPark: " << std::strerror(errno) << std::endl;
@@ -55,17 +81,31 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
     }
 }
 
-void tparkBeginPark(tpark_handle_t *handle) { handle->state.store(1, std::memory_order_seq_cst); }
+void tparkBeginPark(tpark_handle_t *handle) { tparkBeginParkExplicit(handle, TPARK_ORDER_SEQ_CST); }
 
-void tparkEndPark(tpark_handle_t *handle) { handle->state.store(0, std::memory_order_seq_cst); }
+void tparkBeginParkExplicit(tpark_handle_t *handle, const tpark_memory_order_t order) {
+    TPARK_REGISTRY_ON_PARK(handle);
+    handle->state.store(1, tpark_park_order(order));
+}
+
+void tparkEndPark(tpark_handle_t *handle) {
+    // Relaxed: a waker that observes 0 merely skips a wake this thread no longer waits for.
+    // The next tparkBeginPark re-establishes the ordering needed to park again.
+    handle->state.store(0, std::memory_order_relaxed);
+}
 
-void tparkWake(tpark_handle_t *handle) {
-    if (handle->state.load(std::memory_order_seq_cst) == 0) {
+void tparkWake(tpark_handle_t *handle) { tparkWakeExplicit(handle, TPARK_ORDER_SEQ_CST); }
+
+void tparkWakeExplicit(tpark_handle_t *handle, const tpark_memory_order_t order) {
+    if (handle->state.load(tpark_wake_check_order(order)) == 0) {
         // No need to wake up, the thread is not parked
         return;
     }
+    TPARK_REGISTRY_ON_WAKE(handle);
+
     // Set the state to 0 to indicate "not parked"
-    handle->state.store(0, std::memory_order_seq_cst);
+    // Release, so that the woken thread observes everything we wrote before waking it.
+    handle->state.store(0, std::memory_order_release);
 
     // Wake any threads waiting for the value '1'
     // (i.e., threads that called __ulock_wait(..., 1, ...)).
@@ -73,9 +113,46 @@ void tparkWake(tpark_handle_t *handle) {
 }
 
 bool tparkIsParked(const tpark_handle_t *handle) {
-    return handle->state.load(std::memory_order_seq_cst) == 1;
+    return handle->state.load(std::memory_order_acquire) == 1;
+}
+
+void *tpark_park_word(tpark_handle_t *handle) { return &handle->state; }
+
+bool tpark_abandon_park(tpark_handle_t *handle) {
+    uint32_t expected = 1;
+    return handle->state.compare_exchange_strong(expected, 0, std::memory_order_acquire);
 }
 
 void tparkDestroyHandle(const tpark_handle_t *handle) {
-    delete handle;
+    tpark_cancel_detach(&handle->cancel, handle);
+    TPARK_REGISTRY_REMOVE(handle);
+    tpark_numa_delete(handle);
+}
+
+int tparkHandleNode(const tpark_handle_t *handle) { return tpark_numa_handle_node(handle); }
+
+tpark_wait_result_t tparkWaitOnAddress(void *addr, const uint32_t expected, const uint64_t timeout_ns) {
+    if (timeout_ns == 0) {
+        // A zero timeout means "wait forever" to __ulock_wait2, so just poll the value
+        return *static_cast<volatile uint32_t *>(addr) == expected ? TPARK_WAIT_TIMED_OUT : TPARK_WAIT_WOKEN;
+    }
+    if (__ulock_wait2(UL_COMPARE_AND_WAIT, addr, expected, timeout_ns == TPARK_INFINITE ? 0 : timeout_ns, 0) < 0) {
+        if (errno == ETIMEDOUT) {
+            return TPARK_WAIT_TIMED_OUT;
+        }
+        // EINTR => signal; EBUSY => value already changed. Both are treated as spurious wakeups.
+        if (errno != EINTR && errno != EBUSY) {
+            std::cerr << "Unexpected error in tparkWaitOnAddress: " << std::strerror(errno) << std::endl;
+            std::abort();
+        }
+    }
+    return TPARK_WAIT_WOKEN;
+}
+
+void tparkWakeAddress(void *addr, const uint32_t count) {
+    // ulock can only wake one or all waiters
+    if (count == 0) {
+        return;
+    }
+    __ulock_wake(UL_COMPARE_AND_WAIT | (count > 1 ? ULF_WAKE_ALL : 0), addr, 0);
 }
@@ -0,0 +1,108 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+static constexpr int NUM_WORKERS = 256;
+static constexpr int NUM_TASKS = 100000;
+
+/// Dispatches NUM_TASKS tasks to NUM_WORKERS workers, one wake per task, and prints
+/// the mean dispatcher-side cost of one wake and the total time until all tasks are done.
+template<typename BeginPark, typename EndPark, typename WakeOne>
+static void measureDispatch(const char *name, BeginPark beginPark, EndPark endPark, WakeOne wakeOne,
+                            std::vector<tpark_handle_t *> &handles) {
+    std::atomic pendingTasks{0};
+    std::atomic completedTasks{0};
+    std::atomic stop{false};
+
+    const auto tryClaimTask = [&] {
+        int pending = pendingTasks.load();
+        while (pending > 0) {
+            if (pendingTasks.compare_exchange_weak(pending, pending - 1)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < NUM_WORKERS; i++) {
+        workers.emplace_back([&, i] {
+            while (!stop.load()) {
+                beginPark(i);
+                if (!tryClaimTask() && !stop.load()) {
+                    tparkWait(handles[i], true);
+                    endPark(i);
+                    continue;
+                }
+                endPark(i);
+                completedTasks.fetch_add(1);
+            }
+        });
+    }
+
+    std::chrono::nanoseconds wakeTime{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_TASKS; i++) {
+        pendingTasks.fetch_add(1);
+        const auto wakeStart = std::chrono::steady_clock::now();
+        wakeOne();
+        wakeTime += std::chrono::steady_clock::now() - wakeStart;
+    }
+    while (completedTasks.load() != NUM_TASKS) {
+        std::this_thread::yield();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    stop.store(true);
+    for (tpark_handle_t *handle: handles) {
+        tparkWake(handle);
+    }
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+
+    std::printf("%-28s %14.0f %14.1f\n", name,
+                static_cast<double>(wakeTime.count()) / NUM_TASKS,
+                std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+int main() {
+    std::vector<tpark_handle_t *> handles;
+    for (int i = 0; i < NUM_WORKERS; i++) {
+        handles.push_back(tparkCreateHandle());
+    }
+
+    std::printf("%d workers, %d tasks\n", NUM_WORKERS, NUM_TASKS);
+    std::printf("%-28s %14s %14s\n", "strategy", "wake (ns)", "total (ms)");
+
+    tpark_idle_set_t *set = tparkCreateIdleSet(NUM_WORKERS);
+    measureDispatch("tparkIdleSetWakeOne",
+                    [&](const int i) { tparkIdleSetBeginPark(set, i, handles[i]); },
+                    [&](const int i) { tparkIdleSetEndPark(set, i, handles[i]); },
+                    [&] { tparkIdleSetWakeOne(set); },
+                    handles);
+    tparkDestroyIdleSet(set);
+
+    // The approach the idle set replaces: scan all handles and wake the first one that looks parked
+    measureDispatch("scan with tparkIsParked",
+                    [&](const int i) { tparkBeginPark(handles[i]); },
+                    [&](const int i) { tparkEndPark(handles[i]); },
+                    [&] {
+                        for (tpark_handle_t *handle: handles) {
+                            if (tparkIsParked(handle)) {
+                                tparkWake(handle);
+                                return;
+                            }
+                        }
+                    },
+                    handles);
+
+    for (const tpark_handle_t *handle: handles) {
+        tparkDestroyHandle(handle);
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <threadpark.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+static constexpr int NUM_ROUND_TRIPS = 100000;
+
+/// CPU a thread is pinned to; -1 => not pinned
+static void pinCurrentThread(const int cpu) {
+#ifdef __linux__
+    if (cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        sched_setaffinity(0, sizeof(cpus), &cpus);
+    }
+#else
+    (void) cpu;
+#endif
+}
+
+/// Runs a ping-pong between a thread on `wakerCpu` and one on `parkerCpu`, each parking on a handle placed
+/// on its own node, and returns the mean one-way wake latency in nanoseconds.
+static double measureWakeLatency(const int wakerCpu, const int parkerCpu) {
+    tpark_handle_t *pingHandle = nullptr;
+    tpark_handle_t *pongHandle = nullptr;
+    double latencyNs = 0;
+
+    std::thread ponger;
+    std::thread pinger([&] {
+        pinCurrentThread(wakerCpu);
+        pingHandle = tparkCreateHandleOnNode(TPARK_NODE_CURRENT);
+        tparkBeginPark(pingHandle);
+
+        ponger = std::thread([&] {
+            pinCurrentThread(parkerCpu);
+            pongHandle = tparkCreateHandleOnNode(TPARK_NODE_CURRENT);
+            tparkBeginPark(pongHandle);
+            // Signal readiness, then serve round trips until the pinger is done
+            tparkWakeAndWait(pingHandle, pongHandle, true);
+            for (int i = 1; i < NUM_ROUND_TRIPS; i++) {
+                tparkWakeAndWait(pingHandle, pongHandle, false);
+            }
+            tparkWake(pingHandle);
+        });
+        tparkWait(pingHandle, true);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_ROUND_TRIPS; i++) {
+            tparkWakeAndWait(pongHandle, pingHandle, false);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        latencyNs = std::chrono::duration<double, std::nano>(end - start).count() / (2.0 * NUM_ROUND_TRIPS);
+    });
+    pinger.join();
+    ponger.join();
+
+    tparkDestroyHandle(pingHandle);
+    tparkDestroyHandle(pongHandle);
+    return latencyNs;
+}
+
+/// Returns the NUMA node of each CPU the process may run on, indexed by CPU number; -1 => not usable.
+static std::vector<int> cpuNodes() {
+    std::vector<int> nodes;
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return nodes;
+    }
+    // Probe each CPU from a short-lived pinned thread, so that the main thread's affinity is untouched
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        nodes.resize(cpu + 1, -1);
+        std::thread([&] {
+            pinCurrentThread(cpu);
+            nodes[cpu] = tparkCurrentNode();
+        }).join();
+    }
+#endif
+    return nodes;
+}
+
+int main() {
+    const std::vector<int> nodes = cpuNodes();
+
+    // Waker on the first usable CPU; local partner on another CPU of its node, remote partner on another node
+    int wakerCpu = -1;
+    int localCpu = -1;
+    int remoteCpu = -1;
+    for (int cpu = 0; cpu < static_cast<int>(nodes.size()); cpu++) {
+        if (nodes[cpu] < 0) {
+            continue;
+        }
+        if (wakerCpu < 0) {
+            wakerCpu = cpu;
+        } else if (nodes[cpu] == nodes[wakerCpu] && localCpu < 0) {
+            localCpu = cpu;
+        } else if (nodes[cpu] != nodes[wakerCpu] && remoteCpu < 0) {
+            remoteCpu = cpu;
+        }
+    }
+    if (localCpu < 0) {
+        // A single CPU on the node (or no pinning support): both threads share it
+        localCpu = wakerCpu;
+    }
+
+    std::printf("NUMA nodes: %d\n", tparkNodeCount());
+    std::printf("%-40s %12s\n", "wake", "latency (ns)");
+    std::printf("%-40s %12.0f\n", "local (same node)", measureWakeLatency(wakerCpu, localCpu));
+    if (remoteCpu >= 0) {
+        std::printf("%-40s %12.0f\n", "remote (other node)", measureWakeLatency(wakerCpu, remoteCpu));
+    } else {
+        std::printf("%-40s %12s\n", "remote (other node)", "n/a");
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <threadpark.h>
+
+#include <chrono>
+#include <cstdio>
+
+static constexpr int NUM_OPERATIONS = 10000000;
+
+/// Runs `operation` NUM_OPERATIONS times on the calling thread and returns the mean cost in nanoseconds.
+template<typename Operation>
+static double measure(Operation operation) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_OPERATIONS; i++) {
+        operation();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / NUM_OPERATIONS;
+}
+
+int main() {
+    tpark_handle_t *handle = tparkCreateHandle();
+
+    // Uncontended fast paths only: nothing ever blocks, so this isolates the cost of the atomics.
+    const double beginEndSeqCst = measure([&] {
+        tparkBeginParkExplicit(handle, TPARK_ORDER_SEQ_CST);
+        tparkEndPark(handle);
+    });
+    const double beginEndAcqRel = measure([&] {
+        tparkBeginParkExplicit(handle, TPARK_ORDER_ACQ_REL);
+        tparkEndPark(handle);
+    });
+    const double wakeUnparkedSeqCst = measure([&] { tparkWakeExplicit(handle, TPARK_ORDER_SEQ_CST); });
+    const double wakeUnparkedAcqRel = measure([&] { tparkWakeExplicit(handle, TPARK_ORDER_ACQ_REL); });
+    const double isParked = measure([&] {
+        volatile bool parked = tparkIsParked(handle);
+        (void) parked;
+    });
+
+    std::printf("%-40s %10s\n", "operation", "ns/op");
+    std::printf("%-40s %10.2f\n", "begin + end park (seq_cst)", beginEndSeqCst);
+    std::printf("%-40s %10.2f\n", "begin + end park (acq_rel)", beginEndAcqRel);
+    std::printf("%-40s %10.2f\n", "wake unparked handle (seq_cst)", wakeUnparkedSeqCst);
+    std::printf("%-40s %10.2f\n", "wake unparked handle (acq_rel)", wakeUnparkedAcqRel);
+    std::printf("%-40s %10.2f\n", "is parked", isParked);
+
+    tparkDestroyHandle(handle);
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <threadpark.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+static constexpr int NUM_ROUND_TRIPS = 200000;
+
+/// Runs a ping-pong between two threads and returns the mean round-trip time in nanoseconds.
+template<typename Handoff>
+static double measureRoundTrip(Handoff handoff) {
+    tpark_handle_t *pingHandle = tparkCreateHandle();
+    tpark_handle_t *pongHandle = tparkCreateHandle();
+    tparkBeginPark(pongHandle);
+
+    std::thread ponger([&] {
+        tparkWait(pongHandle, true);
+        for (int i = 1; i < NUM_ROUND_TRIPS; i++) {
+            handoff(pingHandle, pongHandle);
+        }
+        tparkWake(pingHandle);
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_ROUND_TRIPS; i++) {
+        handoff(pongHandle, pingHandle);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    ponger.join();
+    tparkDestroyHandle(pingHandle);
+    tparkDestroyHandle(pongHandle);
+    return std::chrono::duration<double, std::nano>(end - start).count() / NUM_ROUND_TRIPS;
+}
+
+int main() {
+    const double separateNs = measureRoundTrip([](tpark_handle_t *wakeHandle, tpark_handle_t *waitHandle) {
+        tparkBeginPark(waitHandle);
+        tparkWake(wakeHandle);
+        tparkWait(waitHandle, true);
+    });
+    const double combinedNs = measureRoundTrip([](tpark_handle_t *wakeHandle, tpark_handle_t *waitHandle) {
+        tparkWakeAndWait(wakeHandle, waitHandle, false);
+    });
+
+    std::printf("%-30s %12s\n", "handoff", "round trip (ns)");
+    std::printf("%-30s %12.0f\n", "tparkWake + tparkWait", separateNs);
+    std::printf("%-30s %12.0f\n", "tparkWakeAndWait", combinedNs);
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <threadpark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+static constexpr auto RUN_DURATION = std::chrono::milliseconds(500);
+
+/// Read-mostly data guarded by the lock under test
+static volatile long long g_sharedValue = 42;
+
+template<typename ReadSection>
+static double measureReadThroughput(const unsigned int numThreads, ReadSection readSection) {
+    std::atomic g_start{false};
+    std::atomic g_stop{false};
+    std::atomic<long long> totalOps{0};
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < numThreads; i++) {
+        threads.emplace_back([&] {
+            while (!g_start.load()) {
+                std::this_thread::yield();
+            }
+            long long ops = 0;
+            while (!g_stop.load(std::memory_order_relaxed)) {
+                readSection();
+                ops++;
+            }
+            totalOps.fetch_add(ops);
+        });
+    }
+
+    g_start.store(true);
+    std::this_thread::sleep_for(RUN_DURATION);
+    g_stop.store(true);
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    return static_cast<double>(totalOps.load()) / std::chrono::duration<double>(RUN_DURATION).count();
+}
+
+int main() {
+    tpark_rwlock_t *lock = tparkCreateRwLock();
+    std::shared_mutex sharedMutex;
+
+    const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%8s %22s %22s\n", "threads", "tpark_rwlock (ops/s)", "shared_mutex (ops/s)");
+    for (unsigned int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        const double tparkOps = measureReadThroughput(numThreads, [&] {
+            tparkRwLockReadLock(lock);
+            (void) g_sharedValue;
+            tparkRwLockReadUnlock(lock);
+        });
+        const double sharedMutexOps = measureReadThroughput(numThreads, [&] {
+            std::shared_lock guard(sharedMutex);
+            (void) g_sharedValue;
+        });
+        std::printf("%8u %22.0f %22.0f\n", numThreads, tparkOps, sharedMutexOps);
+    }
+
+    tparkDestroyRwLock(lock);
+    return 0;
+}
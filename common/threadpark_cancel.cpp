@@ -0,0 +1,82 @@
+#include "threadpark.h"
+#include "threadpark_cancel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+struct tpark_cancel_token_t {
+    /// Set once by tparkCancel; never cleared
+    std::atomic<bool> cancelled{false};
+
+    /// Guards the list of associated handles
+    mutable std::mutex mutex;
+    std::vector<tpark_handle_t *> handles;
+};
+
+static void remove_handle(tpark_cancel_token_t *token, const tpark_handle_t *handle) {
+    std::lock_guard lock(token->mutex);
+    if (const auto it = std::find(token->handles.begin(), token->handles.end(), handle);
+        it != token->handles.end()) {
+        // Order does not matter, so swap with the last element instead of shifting
+        *it = token->handles.back();
+        token->handles.pop_back();
+    }
+}
+
+tpark_cancel_token_t *tparkCreateCancelToken() { return new tpark_cancel_token_t(); }
+
+void tparkCancel(tpark_cancel_token_t *token) {
+    if (token->cancelled.exchange(true, std::memory_order_seq_cst)) {
+        // Already cancelled; the handles were woken back then, and later waits return immediately
+        return;
+    }
+    // Every handle parked at this point is woken. A handle that parks afterwards observes the flag
+    // right after setting its park bit and does not block.
+    std::lock_guard lock(token->mutex);
+    for (tpark_handle_t *handle: token->handles) {
+        tparkWake(handle);
+    }
+}
+
+bool tparkIsCancelled(const tpark_cancel_token_t *token) {
+    return token->cancelled.load(std::memory_order_acquire);
+}
+
+void tparkSetCancelToken(tpark_handle_t *handle, tpark_cancel_token_t *token) {
+    tpark_cancel_link_t *link = tpark_cancel_link(handle);
+    tpark_cancel_token_t *previous = link->token.load(std::memory_order_relaxed);
+    if (previous == token) {
+        return;
+    }
+    if (previous != nullptr) {
+        remove_handle(previous, handle);
+    }
+    if (token != nullptr) {
+        std::lock_guard lock(token->mutex);
+        token->handles.push_back(handle);
+    }
+    link->token.store(token, std::memory_order_release);
+}
+
+void tparkDestroyCancelToken(const tpark_cancel_token_t *token) {
+    {
+        std::lock_guard lock(token->mutex);
+        for (tpark_handle_t *handle: token->handles) {
+            tpark_cancel_link(handle)->token.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    delete token;
+}
+
+bool tpark_cancel_requested(const tpark_cancel_link_t *link) {
+    const tpark_cancel_token_t *token = link->token.load(std::memory_order_acquire);
+    return token != nullptr && token->cancelled.load(std::memory_order_seq_cst);
+}
+
+void tpark_cancel_detach(const tpark_cancel_link_t *link, const tpark_handle_t *handle) {
+    if (tpark_cancel_token_t *token = link->token.load(std::memory_order_relaxed); token != nullptr) {
+        remove_handle(token, handle);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef THREADPARK_CANCEL_H
+#define THREADPARK_CANCEL_H
+
+#include "threadpark.h"
+
+#include <atomic>
+
+/**
+ * Link from a handle to the cancellation token it is associated with, embedded into every handle.
+ * The token in turn keeps the list of its handles, so that cancelling it can wake all of them.
+ */
+struct tpark_cancel_link_t {
+    std::atomic<tpark_cancel_token_t *> token{nullptr};
+};
+
+/**
+ * Returns the cancellation link embedded into a handle. Implemented by each backend, as the handle layout is backend-specific.
+ */
+tpark_cancel_link_t *tpark_cancel_link(tpark_handle_t *handle);
+
+/**
+ * Returns the address of the handle's park bit word, for use with tparkWaitOnAddress. Implemented by each backend.
+ */
+void *tpark_park_word(tpark_handle_t *handle);
+
+/**
+ * Clears the park bit unless a waker already did. Implemented by each backend.
+ * Returns true if the calling thread gave up on the park, false if it was woken in the meantime.
+ */
+bool tpark_abandon_park(tpark_handle_t *handle);
+
+/**
+ * Whether the token associated with the link has been cancelled.
+ * Sequentially consistent, pairing with the park bit store of the waiting thread, so that a
+ * wait either observes the cancellation or is woken by it.
+ */
+bool tpark_cancel_requested(const tpark_cancel_link_t *link);
+
+/**
+ * Result of a wait whose park bit was cleared: cancelled if the token was cancelled, woken otherwise.
+ */
+inline tpark_wait_result_t tpark_cancel_wait_result(const tpark_cancel_link_t *link) {
+    return tpark_cancel_requested(link) ? TPARK_WAIT_CANCELLED : TPARK_WAIT_WOKEN;
+}
+
+/**
+ * Removes a handle that is being destroyed from the handle list of its token, if any.
+ */
+void tpark_cancel_detach(const tpark_cancel_link_t *link, const tpark_handle_t *handle);
+
+#endif /* THREADPARK_CANCEL_H */
@@ -0,0 +1,66 @@
+#include "threadpark.h"
+#include "threadpark_internal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+/// Longest time to poll for the peer's response before blocking.
+/// Spinning only pays off while it is cheaper than blocking, and blocking costs a futex wait, the peer's wake
+/// and a context switch: a few microseconds on current x86 and ARM servers. Spinning longer than that can at best
+/// break even (the classic 2-competitive bound), so the spin is capped there instead of at an iteration count,
+/// whose duration varies by more than 10x between CPUs (e.g. PAUSE takes ~140 cycles from Skylake on).
+/// Tune against ping_pong_benchmark on a multi-core machine.
+static constexpr std::chrono::nanoseconds HANDOFF_MAX_SPIN{4000};
+
+/// Shortest spin budget. A thread whose peer keeps answering late still polls this long,
+/// so that it notices when the peer becomes fast again.
+static constexpr std::chrono::nanoseconds HANDOFF_MIN_SPIN{250};
+
+/// Relax iterations between clock reads, so that reading the clock does not dominate the poll loop
+static constexpr int HANDOFF_POLLS_PER_CLOCK_READ = 8;
+
+/// Per-thread spin budget: back to the maximum whenever the peer answered while we spun, halved whenever it did not.
+/// A thread whose peer is consistently slow thus burns at most HANDOFF_MIN_SPIN per handoff.
+static thread_local std::chrono::nanoseconds handoff_spin_budget = HANDOFF_MAX_SPIN;
+
+/// Spinning only pays off if the peer can run at the same time as we do.
+static bool handoff_spin_enabled() {
+    static const bool enabled = std::thread::hardware_concurrency() > 1;
+    return enabled;
+}
+
+/// Polls the park bit of `waitHandle` for at most `budget`. Returns whether it was cleared.
+static bool spin_for_response(const tpark_handle_t *waitHandle, const std::chrono::nanoseconds budget) {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    while (true) {
+        for (int i = 0; i < HANDOFF_POLLS_PER_CLOCK_READ; i++) {
+            if (!tparkIsParked(waitHandle)) {
+                // The peer answered while we were spinning (or the token was cancelled)
+                return true;
+            }
+            tpark_cpu_relax();
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+    }
+}
+
+tpark_wait_result_t tparkWakeAndWait(tpark_handle_t *wakeHandle, tpark_handle_t *waitHandle, const bool unlocked) {
+    if (!unlocked) {
+        // Set our own park bit before the peer can respond, so its wake cannot be lost
+        tparkBeginPark(waitHandle);
+    }
+    tparkWake(wakeHandle);
+
+    if (handoff_spin_enabled()) {
+        if (spin_for_response(waitHandle, handoff_spin_budget)) {
+            handoff_spin_budget = HANDOFF_MAX_SPIN;
+        } else {
+            handoff_spin_budget = std::max(handoff_spin_budget / 2, HANDOFF_MIN_SPIN);
+        }
+    }
+    // Returns right away if the park bit was already cleared, reporting why
+    return tparkWait(waitHandle, true);
+}
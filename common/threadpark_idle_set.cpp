@@ -0,0 +1,84 @@
+#include "threadpark.h"
+#include "threadpark_internal.h"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+static constexpr size_t BITS_PER_WORD = 64;
+
+struct alignas(CACHE_LINE_SIZE) idle_word_t {
+    /// Bit i set => worker (word index * 64 + i) is parked or about to park
+    std::atomic<uint64_t> idle{0};
+};
+
+struct tpark_idle_set_t {
+    std::vector<idle_word_t> words;
+
+    /// The handle each worker last parked on. Published before the worker's idle bit is set.
+    std::vector<std::atomic<tpark_handle_t *>> handles;
+
+    /// Word to start the next scan at, so that concurrent dispatchers spread over the bitmap
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> next_word{0};
+
+    explicit tpark_idle_set_t(const size_t capacity)
+        : words((capacity + BITS_PER_WORD - 1) / BITS_PER_WORD), handles(capacity) {
+    }
+};
+
+tpark_idle_set_t *tparkCreateIdleSet(const size_t capacity) {
+    if (capacity == 0) {
+        return nullptr;
+    }
+    return new(std::nothrow) tpark_idle_set_t(capacity);
+}
+
+void tparkIdleSetBeginPark(tpark_idle_set_t *set, const size_t worker, tpark_handle_t *handle) {
+    // Set the park bit first, so that a dispatcher which claims us below is guaranteed to wake us
+    tparkBeginPark(handle);
+
+    set->handles[worker].store(handle, std::memory_order_relaxed);
+    set->words[worker / BITS_PER_WORD].idle.fetch_or(uint64_t{1} << (worker % BITS_PER_WORD),
+                                                     std::memory_order_seq_cst);
+}
+
+void tparkIdleSetEndPark(tpark_idle_set_t *set, const size_t worker, tpark_handle_t *handle) {
+    const uint64_t mask = uint64_t{1} << (worker % BITS_PER_WORD);
+    if ((set->words[worker / BITS_PER_WORD].idle.load(std::memory_order_relaxed) & mask) != 0) {
+        set->words[worker / BITS_PER_WORD].idle.fetch_and(~mask, std::memory_order_seq_cst);
+    }
+    tparkEndPark(handle);
+}
+
+bool tparkIdleSetWakeOne(tpark_idle_set_t *set) {
+    const size_t num_words = set->words.size();
+    const size_t start = set->next_word.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < num_words; i++) {
+        const size_t word_index = (start + i) % num_words;
+        std::atomic<uint64_t> &word = set->words[word_index].idle;
+
+        uint64_t idle = word.load(std::memory_order_seq_cst);
+        while (idle != 0) {
+            const uint64_t mask = uint64_t{1} << std::countr_zero(idle);
+
+            // Claim the worker; only the caller that clears the bit gets to wake it
+            const uint64_t previous = word.fetch_and(~mask, std::memory_order_seq_cst);
+            if ((previous & mask) != 0) {
+                if (word_index != start) {
+                    set->next_word.store(word_index, std::memory_order_relaxed);
+                }
+                const size_t worker = word_index * BITS_PER_WORD + std::countr_zero(mask);
+                tparkWake(set->handles[worker].load(std::memory_order_relaxed));
+                return true;
+            }
+            idle = previous & ~mask;
+        }
+    }
+    // No worker is idle
+    return false;
+}
+
+void tparkDestroyIdleSet(const tpark_idle_set_t *set) { delete set; }
@@ -0,0 +1,52 @@
+#ifndef THREADPARK_INTERNAL_H
+#define THREADPARK_INTERNAL_H
+
+#include "threadpark.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// Size of a cache line; contended fields are aligned to it, so that they do not false-share
+static constexpr size_t CACHE_LINE_SIZE = 64;
+
+/// Timeouts this long are treated as infinite, so that computing the deadline cannot overflow
+static constexpr uint64_t MAX_FINITE_TIMEOUT_NS = UINT64_MAX / 4;
+
+/**
+ * Memory order of the park bit store in tparkBeginParkExplicit.
+ */
+inline std::memory_order tpark_park_order(const tpark_memory_order_t order) {
+    return order == TPARK_ORDER_SEQ_CST ? std::memory_order_seq_cst : std::memory_order_release;
+}
+
+/**
+ * Memory order of the "is parked" check in tparkWakeExplicit.
+ */
+inline std::memory_order tpark_wake_check_order(const tpark_memory_order_t order) {
+    return order == TPARK_ORDER_SEQ_CST ? std::memory_order_seq_cst : std::memory_order_acquire;
+}
+
+/**
+ * Hint to the CPU that the calling thread is busy-waiting.
+ * Shared by the synchronization structures in common/ that spin before parking.
+ */
+inline void tpark_cpu_relax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && (defined(_M_ARM64) || defined(_M_ARM))
+    __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+#endif /* THREADPARK_INTERNAL_H */
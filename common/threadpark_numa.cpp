@@ -0,0 +1,43 @@
+#include "threadpark.h"
+#include "threadpark_numa.h"
+
+#include <atomic>
+#include <climits>
+
+int tparkCurrentNode() { return tpark_numa_current_node(); }
+
+int tparkNodeCount() { return tpark_numa_node_count(); }
+
+void tparkWakeMany(tpark_handle_t *const *handles, const size_t count) {
+    // One fence for the whole group instead of a sequentially consistent load per handle
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Local node first: those threads are closest to the data we just published
+    const int local = tpark_numa_current_node();
+    for (size_t i = 0; i < count; i++) {
+        if (tparkHandleNode(handles[i]) == local) {
+            tparkWakeExplicit(handles[i], TPARK_ORDER_ACQ_REL);
+        }
+    }
+
+    // Then the remaining nodes in ascending order. Each pass finds the next node and wakes its handles;
+    // the number of passes is bounded by the number of distinct nodes, which is small.
+    int previous = -1;
+    while (true) {
+        int next = INT_MAX;
+        for (size_t i = 0; i < count; i++) {
+            if (const int node = tparkHandleNode(handles[i]); node != local && node > previous && node < next) {
+                next = node;
+            }
+        }
+        if (next == INT_MAX) {
+            break;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (tparkHandleNode(handles[i]) == next) {
+                tparkWakeExplicit(handles[i], TPARK_ORDER_ACQ_REL);
+            }
+        }
+        previous = next;
+    }
+}
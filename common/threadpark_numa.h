@@ -0,0 +1,96 @@
+#ifndef THREADPARK_NUMA_H
+#define THREADPARK_NUMA_H
+
+#include "threadpark.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+/**
+ * Where a handle's memory came from, embedded into every handle.
+ */
+struct tpark_numa_placement_t {
+    /// NUMA node the handle's memory resides on; -1 => not determined yet.
+    /// Heap handles look it up on first use, so that plain handle creation does not cost a system call.
+    mutable std::atomic<int> node{-1};
+
+    /// Whether the handle lives in a node-local arena rather than on the heap
+    bool arena = false;
+};
+
+/**
+ * Returns the number of NUMA nodes, at least 1. Implemented per platform.
+ */
+int tpark_numa_node_count();
+
+/**
+ * Returns the NUMA node of the CPU the calling thread runs on, or 0 if unknown. Implemented per platform.
+ */
+int tpark_numa_current_node();
+
+/**
+ * Returns the NUMA node backing the given address, or 0 if unknown. Implemented per platform.
+ */
+int tpark_numa_node_of(const void *address);
+
+/**
+ * Allocates memory for one handle from the arena of the given node.
+ * Returns nullptr if node-local placement is unavailable, in which case the caller falls back to the heap.
+ * Implemented per platform. All calls must pass the same `handle_size`.
+ */
+void *tpark_numa_alloc_handle(size_t handle_size, int node);
+
+/**
+ * Returns memory obtained from tpark_numa_alloc_handle to the arena of its node.
+ */
+void tpark_numa_free_handle(void *memory, int node);
+
+/**
+ * Creates a handle, node-local if `node` is not TPARK_NODE_ANY and the platform supports it.
+ */
+template<typename Handle>
+Handle *tpark_numa_new(int node) {
+    if (node == TPARK_NODE_CURRENT) {
+        node = tpark_numa_current_node();
+    }
+    if (node != TPARK_NODE_ANY) {
+        if (void *memory = tpark_numa_alloc_handle(sizeof(Handle), node); memory != nullptr) {
+            auto *handle = new(memory) Handle();
+            handle->numa.node.store(node, std::memory_order_relaxed);
+            handle->numa.arena = true;
+            return handle;
+        }
+    }
+    return new Handle();
+}
+
+/**
+ * Returns the NUMA node of a handle created by tpark_numa_new, looking it up on first use.
+ * Racing first uses may both look it up; they store the same value.
+ */
+template<typename Handle>
+int tpark_numa_handle_node(const Handle *handle) {
+    int node = handle->numa.node.load(std::memory_order_relaxed);
+    if (node < 0) {
+        node = tpark_numa_node_of(handle);
+        handle->numa.node.store(node, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+/**
+ * Destroys a handle created by tpark_numa_new.
+ */
+template<typename Handle>
+void tpark_numa_delete(const Handle *handle) {
+    if (!handle->numa.arena) {
+        delete handle;
+        return;
+    }
+    const int node = handle->numa.node.load(std::memory_order_relaxed);
+    handle->~Handle();
+    tpark_numa_free_handle(const_cast<Handle *>(handle), node);
+}
+
+#endif /* THREADPARK_NUMA_H */
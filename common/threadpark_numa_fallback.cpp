@@ -0,0 +1,17 @@
+#include "threadpark.h"
+#include "threadpark_numa.h"
+
+/// Fallback for platforms without NUMA placement support: every thread and handle is reported
+/// to be on node 0, and node-local handles are allocated on the heap like any other handle.
+
+int tpark_numa_node_count() { return 1; }
+
+int tpark_numa_current_node() { return 0; }
+
+int tpark_numa_node_of(const void *) { return 0; }
+
+void *tpark_numa_alloc_handle(size_t, int) { return nullptr; }
+
+void tpark_numa_free_handle(void *, int) {
+    // Never called, as tpark_numa_alloc_handle never hands out memory
+}
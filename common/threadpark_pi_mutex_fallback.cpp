@@ -0,0 +1,62 @@
+#include "threadpark.h"
+#include "threadpark_internal.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/// Fallback for backends without a priority-inheritance futex: a plain futex-style mutex
+/// with the same API, which parks contenders but does not boost the owner.
+struct tpark_pi_mutex_t {
+    /// The mutex state:
+    ///  - 0 => unlocked
+    ///  - 1 => locked, no waiters
+    ///  - 2 => locked, threads may be parked waiting for it
+    std::atomic<uint32_t> state{0};
+};
+
+tpark_pi_mutex_t *tparkCreatePiMutex() { return new tpark_pi_mutex_t(); }
+
+void tparkPiMutexLock(tpark_pi_mutex_t *mutex) { tparkPiMutexTimedLock(mutex, TPARK_INFINITE); }
+
+bool tparkPiMutexTryLock(tpark_pi_mutex_t *mutex) {
+    uint32_t expected = 0;
+    return mutex->state.compare_exchange_strong(expected, 1, std::memory_order_acquire);
+}
+
+bool tparkPiMutexTimedLock(tpark_pi_mutex_t *mutex, const uint64_t timeout_ns) {
+    // Fast path: uncontended lock without parking
+    uint32_t state = 0;
+    if (mutex->state.compare_exchange_strong(state, 1, std::memory_order_acquire)) {
+        return true;
+    }
+
+    const bool infinite = timeout_ns > MAX_FINITE_TIMEOUT_NS;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(infinite ? 0 : timeout_ns);
+
+    // Mark the mutex as contended, so that the owner wakes us on unlock
+    if (state != 2) {
+        state = mutex->state.exchange(2, std::memory_order_acquire);
+    }
+    while (state != 0) {
+        uint64_t remaining_ns = TPARK_INFINITE;
+        if (!infinite) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+        }
+        tparkWaitOnAddress(&mutex->state, 2, remaining_ns);
+        state = mutex->state.exchange(2, std::memory_order_acquire);
+    }
+    return true;
+}
+
+void tparkPiMutexUnlock(tpark_pi_mutex_t *mutex) {
+    if (mutex->state.exchange(0, std::memory_order_release) == 2) {
+        tparkWakeAddress(&mutex->state, 1);
+    }
+}
+
+void tparkDestroyPiMutex(const tpark_pi_mutex_t *mutex) { delete mutex; }
@@ -0,0 +1,221 @@
+#include "threadpark.h"
+#include "threadpark_registry.h"
+
+#ifdef THREADPARK_REGISTRY
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#elif defined(__FreeBSD__)
+#include <pthread_np.h>
+#elif defined(__OpenBSD__)
+#include <unistd.h>
+#endif
+
+/// Guards the list of live handles, their names and the episodes reported by the watchdog
+static std::mutex g_registry_mutex;
+static tpark_registry_entry_t *g_registry_head = nullptr;
+static size_t g_registry_size = 0;
+
+static std::mutex g_watchdog_mutex;
+static std::condition_variable g_watchdog_cv;
+static std::thread g_watchdog_thread;
+static bool g_watchdog_stop = false;
+
+static uint64_t monotonic_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t query_thread_id() {
+#if defined(_WIN32)
+    return GetCurrentThreadId();
+#elif defined(__linux__)
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+#elif defined(__APPLE__)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return tid;
+#elif defined(__FreeBSD__)
+    return static_cast<uint64_t>(pthread_getthreadid_np());
+#elif defined(__OpenBSD__)
+    return static_cast<uint64_t>(getthrid());
+#else
+    return std::hash<std::thread::id>{}(std::this_thread::get_id());
+#endif
+}
+
+/// Cached per thread, so that recording the waker does not cost a system call on every wake
+static uint64_t current_thread_id() {
+    thread_local const uint64_t id = query_thread_id();
+    return id;
+}
+
+void tpark_registry_add(tpark_registry_entry_t *entry, const tpark_handle_t *handle) {
+    std::lock_guard lock(g_registry_mutex);
+    entry->handle = handle;
+    entry->next = g_registry_head;
+    if (g_registry_head != nullptr) {
+        g_registry_head->prev = entry;
+    }
+    g_registry_head = entry;
+    g_registry_size++;
+}
+
+void tpark_registry_remove(const tpark_registry_entry_t *entry) {
+    std::lock_guard lock(g_registry_mutex);
+    if (entry->prev != nullptr) {
+        entry->prev->next = entry->next;
+    } else {
+        g_registry_head = entry->next;
+    }
+    if (entry->next != nullptr) {
+        entry->next->prev = entry->prev;
+    }
+    g_registry_size--;
+}
+
+void tpark_registry_on_park(tpark_registry_entry_t *entry) {
+    entry->park_start_ns.store(monotonic_now_ns(), std::memory_order_relaxed);
+}
+
+void tpark_registry_on_wake(tpark_registry_entry_t *entry) {
+    entry->last_waker_thread_id.store(current_thread_id(), std::memory_order_relaxed);
+    entry->last_wake_ns.store(monotonic_now_ns(), std::memory_order_relaxed);
+}
+
+/// Must be called with the registry mutex held
+static void fill_info(const tpark_registry_entry_t *entry, const uint64_t park_start, tpark_handle_info_t *info,
+                      const uint64_t now) {
+    info->handle = entry->handle;
+    std::memcpy(info->name, entry->name, sizeof(info->name));
+    info->parked = tparkIsParked(entry->handle);
+    info->park_start_ns = park_start;
+    info->last_wake_ns = entry->last_wake_ns.load(std::memory_order_relaxed);
+    info->last_waker_thread_id = entry->last_waker_thread_id.load(std::memory_order_relaxed);
+    info->snapshot_ns = now;
+}
+
+static void print_stall_report(const tpark_handle_info_t *info, void *) {
+    const auto parked_ms = static_cast<unsigned long long>((info->snapshot_ns - info->park_start_ns) / 1000000);
+    if (info->last_wake_ns == 0) {
+        std::fprintf(stderr, "[threadpark] handle %p (\"%s\") parked for %llu ms, never woken\n",
+                     static_cast<const void *>(info->handle), info->name, parked_ms);
+        return;
+    }
+    std::fprintf(stderr, "[threadpark] handle %p (\"%s\") parked for %llu ms, last woken %llu ms ago by thread %llu\n",
+                 static_cast<const void *>(info->handle), info->name, parked_ms,
+                 static_cast<unsigned long long>((info->snapshot_ns - info->last_wake_ns) / 1000000),
+                 static_cast<unsigned long long>(info->last_waker_thread_id));
+}
+
+static void watchdog_main(const uint64_t threshold_ms, const uint64_t interval_ms,
+                          const tpark_stall_callback_t callback, void *user_data) {
+    const uint64_t threshold_ns = threshold_ms * 1000000;
+    std::vector<tpark_handle_info_t> stalled;
+    while (true) {
+        {
+            std::unique_lock lock(g_watchdog_mutex);
+            if (g_watchdog_cv.wait_for(lock, std::chrono::milliseconds(interval_ms), [] { return g_watchdog_stop; })) {
+                return;
+            }
+        }
+
+        // Collect stalled handles under the registry lock, but report them without it,
+        // so that the callback may freely use the threadpark API.
+        stalled.clear();
+        {
+            std::lock_guard lock(g_registry_mutex);
+            const uint64_t now = monotonic_now_ns();
+            for (tpark_registry_entry_t *entry = g_registry_head; entry != nullptr; entry = entry->next) {
+                // Parkers write park_start_ns without the registry lock, so it may be newer than `now`
+                const uint64_t park_start = entry->park_start_ns.load(std::memory_order_relaxed);
+                if (park_start == 0 || park_start > now || park_start == entry->reported_park_start_ns ||
+                    now - park_start < threshold_ns || !tparkIsParked(entry->handle)) {
+                    continue;
+                }
+                entry->reported_park_start_ns = park_start;
+                fill_info(entry, park_start, &stalled.emplace_back(), now);
+            }
+        }
+        for (const tpark_handle_info_t &info: stalled) {
+            callback(&info, user_data);
+        }
+    }
+}
+
+bool tparkRegistryEnabled() { return true; }
+
+void tparkSetHandleName(tpark_handle_t *handle, const char *name) {
+    tpark_registry_entry_t *entry = tpark_registry_entry(handle);
+    std::lock_guard lock(g_registry_mutex);
+    std::memset(entry->name, 0, sizeof(entry->name));
+    if (name != nullptr) {
+        std::strncpy(entry->name, name, sizeof(entry->name) - 1);
+    }
+}
+
+size_t tparkRegistrySnapshot(tpark_handle_info_t *infos, const size_t capacity) {
+    std::lock_guard lock(g_registry_mutex);
+    size_t i = 0;
+    for (const tpark_registry_entry_t *entry = g_registry_head; entry != nullptr && i < capacity; entry = entry->next) {
+        // Sample the clock after loading the park start, so that snapshot_ns - park_start_ns cannot underflow
+        const uint64_t park_start = entry->park_start_ns.load(std::memory_order_relaxed);
+        fill_info(entry, park_start, &infos[i++], monotonic_now_ns());
+    }
+    return g_registry_size;
+}
+
+bool tparkStartWatchdog(const uint64_t threshold_ms, const uint64_t interval_ms,
+                        const tpark_stall_callback_t callback, void *user_data) {
+    std::lock_guard lock(g_watchdog_mutex);
+    if (g_watchdog_thread.joinable()) {
+        return false;
+    }
+    g_watchdog_stop = false;
+    g_watchdog_thread = std::thread(watchdog_main, threshold_ms, interval_ms,
+                                    callback != nullptr ? callback : print_stall_report, user_data);
+    return true;
+}
+
+void tparkStopWatchdog() {
+    std::thread thread;
+    {
+        std::lock_guard lock(g_watchdog_mutex);
+        if (!g_watchdog_thread.joinable()) {
+            return;
+        }
+        g_watchdog_stop = true;
+        thread = std::move(g_watchdog_thread);
+    }
+    g_watchdog_cv.notify_all();
+    thread.join();
+}
+
+#else
+
+bool tparkRegistryEnabled() { return false; }
+
+void tparkSetHandleName(tpark_handle_t *, const char *) {
+}
+
+size_t tparkRegistrySnapshot(tpark_handle_info_t *, size_t) { return 0; }
+
+bool tparkStartWatchdog(uint64_t, uint64_t, tpark_stall_callback_t, void *) { return false; }
+
+void tparkStopWatchdog() {
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef THREADPARK_REGISTRY_H
+#define THREADPARK_REGISTRY_H
+
+#include "threadpark.h"
+
+#ifdef THREADPARK_REGISTRY
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Bookkeeping embedded into every handle when the registry is compiled in.
+ * Entries form an intrusive list guarded by the registry mutex; the timestamps are
+ * written lock-free by the parking and waking threads.
+ */
+struct tpark_registry_entry_t {
+    tpark_registry_entry_t *prev = nullptr;
+    tpark_registry_entry_t *next = nullptr;
+    const tpark_handle_t *handle = nullptr;
+
+    /// Debug name, guarded by the registry mutex
+    char name[TPARK_HANDLE_NAME_MAX]{};
+
+    /// Monotonic timestamps in nanoseconds; 0 => never happened
+    std::atomic<uint64_t> park_start_ns{0};
+    std::atomic<uint64_t> last_wake_ns{0};
+    std::atomic<uint64_t> last_waker_thread_id{0};
+
+    /// Park start of the episode the watchdog last reported, guarded by the registry mutex
+    uint64_t reported_park_start_ns = 0;
+};
+
+/**
+ * Returns the registry entry embedded into a handle. Implemented by each backend, as the handle layout is backend-specific.
+ */
+tpark_registry_entry_t *tpark_registry_entry(tpark_handle_t *handle);
+
+void tpark_registry_add(tpark_registry_entry_t *entry, const tpark_handle_t *handle);
+
+void tpark_registry_remove(const tpark_registry_entry_t *entry);
+
+void tpark_registry_on_park(tpark_registry_entry_t *entry);
+
+void tpark_registry_on_wake(tpark_registry_entry_t *entry);
+
+#define TPARK_REGISTRY_ENTRY tpark_registry_entry_t registry;
+#define TPARK_REGISTRY_ENTRY_ACCESSOR \
+    tpark_registry_entry_t *tpark_registry_entry(tpark_handle_t *handle) { return &handle->registry; }
+#define TPARK_REGISTRY_ADD(handle) tpark_registry_add(&(handle)->registry, (handle))
+#define TPARK_REGISTRY_REMOVE(handle) tpark_registry_remove(&(handle)->registry)
+#define TPARK_REGISTRY_ON_PARK(handle) tpark_registry_on_park(&(handle)->registry)
+#define TPARK_REGISTRY_ON_WAKE(handle) tpark_registry_on_wake(&(handle)->registry)
+
+#else
+
+#define TPARK_REGISTRY_ENTRY
+#define TPARK_REGISTRY_ENTRY_ACCESSOR
+#define TPARK_REGISTRY_ADD(handle) ((void) 0)
+#define TPARK_REGISTRY_REMOVE(handle) ((void) 0)
+#define TPARK_REGISTRY_ON_PARK(handle) ((void) 0)
+#define TPARK_REGISTRY_ON_WAKE(handle) ((void) 0)
+
+#endif
+
+#endif /* THREADPARK_REGISTRY_H */
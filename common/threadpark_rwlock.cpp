@@ -0,0 +1,112 @@
+#include "threadpark.h"
+#include "threadpark_internal.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// Number of distributed reader counters per lock.
+/// Threads are bound to a slot round-robin the first time they take a read lock.
+static constexpr size_t READER_SLOTS = 64;
+
+struct alignas(CACHE_LINE_SIZE) reader_slot_t {
+    /// Number of readers currently holding (or trying to take) the lock through this slot
+    std::atomic<uint32_t> readers{0};
+};
+
+struct tpark_rwlock_t {
+    /// The writer state:
+    ///  - 0 => no writer
+    ///  - 1 => a writer holds the lock or is draining readers
+    ///  - 2 => same as 1, but other threads are parked waiting for the writer to release
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> writer{0};
+
+    /// Set to 1 by the writer while it is parked waiting for a reader slot to drain.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> draining{0};
+
+    reader_slot_t slots[READER_SLOTS];
+};
+
+static reader_slot_t &this_thread_slot(tpark_rwlock_t *lock) {
+    static std::atomic<size_t> next_slot{0};
+    thread_local const size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+    return lock->slots[slot];
+}
+
+static void release_slot(tpark_rwlock_t *lock, reader_slot_t &slot) {
+    if (slot.readers.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+        lock->writer.load(std::memory_order_seq_cst) != 0) {
+        // We were the last reader of this slot and a writer may be waiting for it to drain
+        if (lock->draining.exchange(0, std::memory_order_seq_cst) == 1) {
+            tparkWakeAddress(&lock->draining, 1);
+        }
+    }
+}
+
+static void wait_for_writer(tpark_rwlock_t *lock) {
+    uint32_t state = lock->writer.load(std::memory_order_seq_cst);
+    while (state != 0) {
+        // Mark the writer state as contended so that the writer wakes us on release
+        if (state == 2 || lock->writer.compare_exchange_weak(state, 2, std::memory_order_seq_cst)) {
+            tparkWaitOnAddress(&lock->writer, 2, TPARK_INFINITE);
+        }
+        state = lock->writer.load(std::memory_order_seq_cst);
+    }
+}
+
+tpark_rwlock_t *tparkCreateRwLock() { return new tpark_rwlock_t(); }
+
+void tparkRwLockReadLock(tpark_rwlock_t *lock) {
+    reader_slot_t &slot = this_thread_slot(lock);
+    while (true) {
+        // Announce ourselves first, then check for writers.
+        // A writer does the opposite, so at least one of us is guaranteed to see the other.
+        slot.readers.fetch_add(1, std::memory_order_seq_cst);
+        if (lock->writer.load(std::memory_order_seq_cst) == 0) {
+            return;
+        }
+
+        // A writer holds or is waiting for the lock; back out so it can drain the readers
+        release_slot(lock, slot);
+        wait_for_writer(lock);
+    }
+}
+
+void tparkRwLockReadUnlock(tpark_rwlock_t *lock) {
+    release_slot(lock, this_thread_slot(lock));
+}
+
+void tparkRwLockWriteLock(tpark_rwlock_t *lock) {
+    // Take the writer state first. This excludes other writers and turns away new readers.
+    if (uint32_t state = 0; !lock->writer.compare_exchange_strong(state, 1, std::memory_order_seq_cst)) {
+        if (state != 2) {
+            state = lock->writer.exchange(2, std::memory_order_seq_cst);
+        }
+        while (state != 0) {
+            tparkWaitOnAddress(&lock->writer, 2, TPARK_INFINITE);
+            state = lock->writer.exchange(2, std::memory_order_seq_cst);
+        }
+    }
+
+    // Wait for the readers that got in before us to leave
+    for (reader_slot_t &slot: lock->slots) {
+        while (slot.readers.load(std::memory_order_seq_cst) != 0) {
+            lock->draining.store(1, std::memory_order_seq_cst);
+
+            // Double-check the slot before actually blocking
+            if (slot.readers.load(std::memory_order_seq_cst) != 0) {
+                tparkWaitOnAddress(&lock->draining, 1, TPARK_INFINITE);
+            }
+        }
+    }
+    lock->draining.store(0, std::memory_order_relaxed);
+}
+
+void tparkRwLockWriteUnlock(tpark_rwlock_t *lock) {
+    if (lock->writer.exchange(0, std::memory_order_seq_cst) == 2) {
+        // Readers and writers share the writer state word, so wake all of them
+        tparkWakeAddress(&lock->writer, TPARK_WAKE_ALL);
+    }
+}
+
+void tparkDestroyRwLock(const tpark_rwlock_t *lock) { delete lock; }
@@ -0,0 +1,35 @@
+#include "threadpark.h"
+#include "threadpark_cancel.h"
+#include "threadpark_internal.h"
+
+#include <chrono>
+
+tpark_wait_result_t tparkTimedWait(tpark_handle_t *handle, const bool unlocked, const uint64_t timeout_ns) {
+    if (timeout_ns > MAX_FINITE_TIMEOUT_NS) {
+        return tparkWait(handle, unlocked);
+    }
+    if (!unlocked) {
+        tparkBeginPark(handle);
+    }
+    const tpark_cancel_link_t *link = tpark_cancel_link(handle);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeout_ns);
+
+    while (tparkIsParked(handle)) {
+        if (tpark_cancel_requested(link)) {
+            tparkEndPark(handle);
+            return TPARK_WAIT_CANCELLED;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            // A waker may clear the park bit concurrently; its wake then wins over the timeout
+            if (tpark_abandon_park(handle)) {
+                return TPARK_WAIT_TIMED_OUT;
+            }
+            break;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+        // Spurious returns and timeouts are both re-evaluated by the loop
+        tparkWaitOnAddress(tpark_park_word(handle), 1, remaining.count());
+    }
+    return tpark_cancel_wait_result(link);
+}
@@ -4,6 +4,8 @@
 #ifndef __cplusplus
 #include <stdbool.h>
 #endif
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -61,6 +63,25 @@ THREAD_PARK_EXPORT tpark_handle_t *tparkCreateHandle(void);
  */
 THREAD_PARK_EXPORT void tparkBeginPark(tpark_handle_t *handle);
 
+/**
+ * @brief Reason a wait returned.
+ */
+typedef enum tpark_wait_result_t {
+    /// The waiter was woken, or the waited-on state had already changed (may be spurious).
+    TPARK_WAIT_WOKEN = 0,
+
+    /// The timeout expired before the waiter was woken.
+    TPARK_WAIT_TIMED_OUT = 1,
+
+    /// The cancellation token associated with the handle was cancelled (see @ref tparkSetCancelToken).
+    TPARK_WAIT_CANCELLED = 2
+} tpark_wait_result_t;
+
+/**
+ * @brief Timeout value that makes a timed wait block indefinitely.
+ */
+#define TPARK_INFINITE UINT64_MAX
+
 /**
  * @brief Actually park (block) the calling thread (second phase).
  *
@@ -83,6 +104,8 @@ THREAD_PARK_EXPORT void tparkBeginPark(tpark_handle_t *handle);
  *                 was already set by @ref tparkBeginPark:
  *                   - false => This call sets the bit itself, then blocks.
  *                   - true  => The bit is assumed to be set already; just block if still needed.
+ * @return @ref TPARK_WAIT_CANCELLED if the handle's cancellation token is cancelled, @ref TPARK_WAIT_WOKEN otherwise.
+ *         If the token was already cancelled, the call returns immediately without blocking.
  *
  * @warning tparkWait unblocks *fast*. It is your responsibility to ensure that any state you access after waking
  * up is already visible to the waking thread. If you are accessing state that the waking thread modified moments
@@ -92,7 +115,21 @@ THREAD_PARK_EXPORT void tparkBeginPark(tpark_handle_t *handle);
  * not guaranteed up-to-date. It is likely you will not be able to avoid some form of looping in the waking thread
  * until all state is visible.
  */
-THREAD_PARK_EXPORT void tparkWait(tpark_handle_t *handle, bool unlocked);
+THREAD_PARK_EXPORT tpark_wait_result_t tparkWait(tpark_handle_t *handle, bool unlocked);
+
+/**
+ * @brief Variant of @ref tparkWait that blocks for at most the specified time.
+ *
+ * If the timeout expires, the "park bit" is cleared before returning, unless another thread
+ * wakes the handle at the same moment, in which case the wake takes precedence.
+ *
+ * @param handle     Pointer to the thread parking handle.
+ * @param unlocked   Same meaning as for @ref tparkWait.
+ * @param timeout_ns Maximum time to block, in nanoseconds, or @ref TPARK_INFINITE.
+ * @return @ref TPARK_WAIT_CANCELLED if the handle's cancellation token is cancelled,
+ *         @ref TPARK_WAIT_TIMED_OUT if the timeout expired, @ref TPARK_WAIT_WOKEN otherwise.
+ */
+THREAD_PARK_EXPORT tpark_wait_result_t tparkTimedWait(tpark_handle_t *handle, bool unlocked, uint64_t timeout_ns);
 
 /**
  * @brief Conclude or "undo" the parking state (final phase).
@@ -127,6 +164,72 @@ THREAD_PARK_EXPORT void tparkEndPark(tpark_handle_t *handle);
  */
 THREAD_PARK_EXPORT void tparkWake(tpark_handle_t *handle);
 
+/**
+ * @brief Memory ordering for the explicit variants of the park/wake fast paths.
+ */
+typedef enum tpark_memory_order_t {
+    /// Sequentially consistent; what @ref tparkBeginPark and @ref tparkWake use.
+    TPARK_ORDER_SEQ_CST = 0,
+
+    /// Release for @ref tparkBeginParkExplicit, acquire for @ref tparkWakeExplicit.
+    /// The caller must supply the sequentially consistent fence itself.
+    TPARK_ORDER_ACQ_REL = 1
+} tpark_memory_order_t;
+
+/**
+ * @brief Variant of @ref tparkBeginPark with caller-chosen memory ordering.
+ *
+ * The park bit is what makes a later @ref tparkWake see the parking thread. With
+ * @ref TPARK_ORDER_SEQ_CST this call is identical to @ref tparkBeginPark.
+ *
+ * With @ref TPARK_ORDER_ACQ_REL the park bit is set with a plain release store, which avoids
+ * a locked instruction / full fence. The caller must then issue a sequentially consistent fence
+ * (e.g. `atomic_thread_fence(memory_order_seq_cst)`, or any seq-cst read-modify-write) between
+ * this call and its re-check of the condition it is about to park on. Otherwise the re-check may
+ * be ordered before the park bit and a wake can be lost.
+ *
+ * @param handle Pointer to the thread parking handle.
+ * @param order  Memory ordering of the park bit store.
+ */
+THREAD_PARK_EXPORT void tparkBeginParkExplicit(tpark_handle_t *handle, tpark_memory_order_t order);
+
+/**
+ * @brief Variant of @ref tparkWake with caller-chosen memory ordering.
+ *
+ * @ref tparkWake first checks whether the handle is parked at all, and only then issues a wake.
+ * With @ref TPARK_ORDER_SEQ_CST this call is identical to @ref tparkWake.
+ *
+ * With @ref TPARK_ORDER_ACQ_REL that check is an acquire load. The caller must then issue a
+ * sequentially consistent fence between publishing the state the parked thread waits for and
+ * this call. Otherwise the check may be ordered before the publication and a wake can be lost.
+ *
+ * @param handle Pointer to the thread parking handle.
+ * @param order  Memory ordering of the "is parked" check.
+ */
+THREAD_PARK_EXPORT void tparkWakeExplicit(tpark_handle_t *handle, tpark_memory_order_t order);
+
+/**
+ * @brief Wake the thread parked on one handle, then park the calling thread on another.
+ *
+ * Intended for request/response handoffs (e.g. ping-pong between two threads), where each
+ * side wakes its peer and then waits for the answer. Equivalent to calling @ref tparkWake on
+ * `wakeHandle` followed by @ref tparkWait on `waitHandle`, with the following differences:
+ *
+ * - The "park bit" of `waitHandle` is set *before* the peer is woken (unless `unlocked = true`),
+ *   so a response that arrives immediately cannot be lost.
+ * - On multi-core machines the calling thread briefly spins for the response before blocking,
+ *   so a fast peer is answered without a blocking system call. The spin lasts at most a few
+ *   microseconds and shrinks while the peer keeps answering too late for it to pay off.
+ *
+ * @param wakeHandle Pointer to the handle of the thread to wake.
+ * @param waitHandle Pointer to the handle the calling thread parks on.
+ * @param unlocked   Same meaning as for @ref tparkWait:
+ *                     - false => This call sets the "park bit" of `waitHandle` itself before waking the peer.
+ *                     - true  => The bit is assumed to be set already via @ref tparkBeginPark.
+ * @return Same as @ref tparkWait for `waitHandle`.
+ */
+THREAD_PARK_EXPORT tpark_wait_result_t tparkWakeAndWait(tpark_handle_t *wakeHandle, tpark_handle_t *waitHandle, bool unlocked);
+
 /**
  * @brief Check if a thread is currently parked.
  * @param handle Pointer to the thread parking handle.
@@ -141,11 +244,475 @@ THREAD_PARK_EXPORT bool tparkIsParked(const tpark_handle_t *handle);
  * Cleans up resources associated with the handle. Once destroyed,
  * the handle is no longer valid and must not be used.
  *
+ * If the handle is associated with a cancellation token, it is detached from the token.
+ *
  * @param handle Pointer to the thread parking handle to destroy.
  *               Must have been created by @ref tparkCreateHandle.
  */
 THREAD_PARK_EXPORT void tparkDestroyHandle(const tpark_handle_t *handle);
 
+/**
+ * @brief Node argument of @ref tparkCreateHandleOnNode that requests no particular placement.
+ */
+#define TPARK_NODE_ANY (-1)
+
+/**
+ * @brief Node argument of @ref tparkCreateHandleOnNode that places the handle on the calling thread's node.
+ */
+#define TPARK_NODE_CURRENT (-2)
+
+/**
+ * @brief Create a new thread parking handle placed on a specific NUMA node.
+ *
+ * Behaves like @ref tparkCreateHandle, but allocates the handle from a per-node arena whose memory
+ * resides on `node`. Creating the handle on the node of the thread that parks on it keeps park/wake
+ * traffic off the interconnect on multi-socket machines. Arena slots are cache-line aligned, so handles
+ * never share a cache line with each other.
+ *
+ * On Linux, placement uses `mbind` with a preferred policy, so allocation falls back to other nodes
+ * when the node is out of memory. On single-node machines, on other platforms, or if the kernel rejects
+ * the NUMA system calls, the handle is allocated like one from @ref tparkCreateHandle.
+ *
+ * @param node NUMA node to place the handle on, @ref TPARK_NODE_CURRENT for the calling thread's node,
+ *             or @ref TPARK_NODE_ANY for no particular placement.
+ * @return Pointer to a newly allocated tpark_handle_t on success,
+ *         or NULL on failure.
+ */
+THREAD_PARK_EXPORT tpark_handle_t *tparkCreateHandleOnNode(int node);
+
+/**
+ * @brief Get the NUMA node a handle's memory resides on.
+ *
+ * For handles created without placement, the node is looked up (one system call on multi-node
+ * Linux machines) on the first call and cached, so that creating them stays as cheap as before.
+ *
+ * @param handle Pointer to the thread parking handle.
+ * @return The node of the handle, or 0 if it is unknown (e.g. on single-node machines or other platforms).
+ */
+THREAD_PARK_EXPORT int tparkHandleNode(const tpark_handle_t *handle);
+
+/**
+ * @brief Get the NUMA node of the CPU the calling thread is currently running on.
+ *
+ * @return The node of the calling thread, or 0 if it is unknown.
+ * @warning Unless the thread is pinned, the scheduler may migrate it to another node at any time.
+ */
+THREAD_PARK_EXPORT int tparkCurrentNode(void);
+
+/**
+ * @brief Get the number of NUMA nodes of the machine.
+ *
+ * @return The number of nodes; 1 on single-node machines and on platforms without NUMA support.
+ */
+THREAD_PARK_EXPORT int tparkNodeCount(void);
+
+/**
+ * @brief Wake the threads parked on a group of handles, grouped by NUMA node.
+ *
+ * Equivalent to calling @ref tparkWake on every handle, except that the wakes are issued node by
+ * node: first the handles on the calling thread's node, then the handles of each other node in
+ * ascending node order. The handles of one node are thus woken together rather than interleaved
+ * with cross-node traffic. A single sequentially consistent fence is issued for the whole group
+ * instead of one per handle.
+ *
+ * @param handles Array of `count` handles to wake.
+ * @param count   Number of handles in `handles`.
+ */
+THREAD_PARK_EXPORT void tparkWakeMany(tpark_handle_t *const *handles, size_t count);
+
+/**
+ * @brief Opaque structure representing a cancellation token.
+ *
+ * Handles are associated with a token via @ref tparkSetCancelToken. Cancelling the token
+ * wakes every associated handle that is parked, and every later wait on an associated
+ * handle returns @ref TPARK_WAIT_CANCELLED immediately. This allows draining all threads
+ * parked on behalf of e.g. a request or a shutdown without tracking them individually.
+ */
+typedef struct tpark_cancel_token_t tpark_cancel_token_t;
+
+/**
+ * @brief Create a new cancellation token.
+ *
+ * A newly created token is not cancelled and has no associated handles.
+ *
+ * @return Pointer to a newly allocated tpark_cancel_token_t on success,
+ *         or NULL on failure.
+ */
+THREAD_PARK_EXPORT tpark_cancel_token_t *tparkCreateCancelToken(void);
+
+/**
+ * @brief Cancel a token and wake all threads parked on its associated handles.
+ *
+ * Cancellation is permanent. A thread that is about to park on an associated handle
+ * cannot miss it: either it is woken by this call, or its wait observes the cancellation
+ * and returns without blocking. Cancelling a token more than once has no further effect.
+ *
+ * @param token Pointer to the cancellation token.
+ */
+THREAD_PARK_EXPORT void tparkCancel(tpark_cancel_token_t *token);
+
+/**
+ * @brief Check whether a token has been cancelled.
+ *
+ * @param token Pointer to the cancellation token.
+ * @return true if @ref tparkCancel was called on the token, false otherwise.
+ */
+THREAD_PARK_EXPORT bool tparkIsCancelled(const tpark_cancel_token_t *token);
+
+/**
+ * @brief Associate a handle with a cancellation token, replacing any previous association.
+ *
+ * A handle is associated with at most one token, while a token may have any number of handles.
+ * Associating a handle with an already cancelled token makes every subsequent wait on it return
+ * @ref TPARK_WAIT_CANCELLED immediately.
+ *
+ * @param handle Pointer to the thread parking handle.
+ * @param token  Pointer to the cancellation token, or NULL to detach the handle from its token.
+ * @warning Must not be called while a thread is waiting on the handle.
+ */
+THREAD_PARK_EXPORT void tparkSetCancelToken(tpark_handle_t *handle, tpark_cancel_token_t *token);
+
+/**
+ * @brief Destroy an existing cancellation token.
+ *
+ * All handles still associated with the token are detached from it.
+ *
+ * @param token Pointer to the cancellation token to destroy.
+ *              Must have been created by @ref tparkCreateCancelToken, and no thread may be
+ *              waiting on one of its handles.
+ */
+THREAD_PARK_EXPORT void tparkDestroyCancelToken(const tpark_cancel_token_t *token);
+
+/**
+ * @brief Wake count that wakes every thread waiting on an address.
+ */
+#define TPARK_WAKE_ALL UINT32_MAX
+
+/**
+ * @brief Block the calling thread while a caller-owned 32-bit word holds an expected value.
+ *
+ * Lets any 32-bit atomic word be parked on directly, without allocating a handle.
+ * The comparison and the decision to block happen atomically with respect to
+ * @ref tparkWakeAddress, so a wake that follows a store to the word cannot be lost.
+ *
+ * @param addr       Address of a naturally aligned 32-bit word (e.g. a `std::atomic<uint32_t>` or `_Atomic uint32_t`).
+ * @param expected   The thread only blocks if `*addr == expected`.
+ * @param timeout_ns Maximum time to block, in nanoseconds, or @ref TPARK_INFINITE.
+ * @return @ref TPARK_WAIT_TIMED_OUT if the timeout expired, @ref TPARK_WAIT_WOKEN otherwise.
+ * @warning Like the underlying OS primitives, this may return spuriously. Callers must re-check
+ * the value of the word in a loop.
+ */
+THREAD_PARK_EXPORT tpark_wait_result_t tparkWaitOnAddress(void *addr, uint32_t expected, uint64_t timeout_ns);
+
+/**
+ * @brief Wake threads blocked in @ref tparkWaitOnAddress on the specified address.
+ *
+ * Store the new value to the word *before* calling this function.
+ *
+ * @param addr  Address of the 32-bit word passed to @ref tparkWaitOnAddress.
+ * @param count Maximum number of waiters to wake, or @ref TPARK_WAKE_ALL. A count of 0 wakes no one.
+ *              Backends that can only wake one or all waiters (Windows, macOS) wake all of them if `count > 1`.
+ */
+THREAD_PARK_EXPORT void tparkWakeAddress(void *addr, uint32_t count);
+
+/**
+ * @brief Maximum length of a handle debug name, including the terminating null character.
+ */
+#define TPARK_HANDLE_NAME_MAX 32
+
+/**
+ * @brief Point-in-time information about a live handle, as reported by the handle registry.
+ *
+ * All timestamps are taken from a monotonic clock, in nanoseconds. A timestamp of 0 means
+ * the corresponding event has not happened yet.
+ */
+typedef struct tpark_handle_info_t {
+    /// The handle this information describes. Only valid for as long as the handle is not destroyed.
+    const tpark_handle_t *handle;
+
+    /// Debug name assigned via @ref tparkSetHandleName, or an empty string.
+    char name[TPARK_HANDLE_NAME_MAX];
+
+    /// Whether the handle was parked at the time of the snapshot (see @ref tparkIsParked).
+    bool parked;
+
+    /// When the handle was last parked via @ref tparkBeginPark or @ref tparkWait.
+    uint64_t park_start_ns;
+
+    /// When a thread last woke the handle while it was parked.
+    uint64_t last_wake_ns;
+
+    /// OS thread id of the thread that last woke the handle while it was parked, or 0.
+    uint64_t last_waker_thread_id;
+
+    /// When the snapshot was taken; compare against the other timestamps to obtain durations.
+    uint64_t snapshot_ns;
+} tpark_handle_info_t;
+
+/**
+ * @brief Callback invoked by the stall watchdog for every handle parked longer than the threshold.
+ *
+ * @param info      Information about the stalled handle. Only valid for the duration of the call.
+ * @param user_data The pointer passed to @ref tparkStartWatchdog.
+ */
+typedef void (*tpark_stall_callback_t)(const tpark_handle_info_t *info, void *user_data);
+
+/**
+ * @brief Check whether the handle registry was compiled in.
+ *
+ * The registry is opt-in and enabled with the CMake option `THREAD_PARK_ENABLE_REGISTRY`.
+ * When it is compiled out, handles carry no registry state and the registry functions are no-ops.
+ *
+ * @return true if the registry is available, false otherwise.
+ */
+THREAD_PARK_EXPORT bool tparkRegistryEnabled(void);
+
+/**
+ * @brief Assign a debug name to a handle.
+ *
+ * The name is reported by @ref tparkRegistrySnapshot and the stall watchdog.
+ * Names longer than @ref TPARK_HANDLE_NAME_MAX - 1 characters are truncated.
+ * No-op if the registry is compiled out.
+ *
+ * @param handle Pointer to the thread parking handle.
+ * @param name   Null-terminated debug name; NULL clears the name.
+ */
+THREAD_PARK_EXPORT void tparkSetHandleName(tpark_handle_t *handle, const char *name);
+
+/**
+ * @brief Take a snapshot of all live handles.
+ *
+ * Fills up to `capacity` entries of `infos` and returns the total number of live handles,
+ * which may be larger than `capacity`. Pass `capacity = 0` to query the count only.
+ *
+ * @param infos    Output array with room for at least `capacity` entries; may be NULL if `capacity` is 0.
+ * @param capacity Number of entries available in `infos`.
+ * @return The number of live handles, or 0 if the registry is compiled out.
+ * @warning The snapshot is best-effort: handles are not frozen while it is taken.
+ */
+THREAD_PARK_EXPORT size_t tparkRegistrySnapshot(tpark_handle_info_t *infos, size_t capacity);
+
+/**
+ * @brief Start a background watchdog that reports handles parked for longer than a threshold.
+ *
+ * Every `interval_ms` milliseconds the watchdog scans the registry and invokes `callback` once for
+ * each park episode that has lasted longer than `threshold_ms` milliseconds.
+ * The callback runs on the watchdog thread without any registry lock held.
+ *
+ * @param threshold_ms Minimum park duration before a handle is reported.
+ * @param interval_ms  Time between two scans.
+ * @param callback     Function invoked for each stalled handle; NULL prints a report to stderr.
+ * @param user_data    Opaque pointer passed to `callback`.
+ * @return true if the watchdog was started, false if it is already running or the registry is compiled out.
+ */
+THREAD_PARK_EXPORT bool tparkStartWatchdog(uint64_t threshold_ms, uint64_t interval_ms,
+                                           tpark_stall_callback_t callback, void *user_data);
+
+/**
+ * @brief Stop the watchdog started by @ref tparkStartWatchdog and wait for its thread to exit.
+ *
+ * No-op if the watchdog is not running.
+ */
+THREAD_PARK_EXPORT void tparkStopWatchdog(void);
+
+/**
+ * @brief Opaque structure representing a set of idle (parked) workers.
+ *
+ * Workers are identified by an index in `[0, capacity)` and announce themselves in a
+ * lock-free bitmap as part of parking. A dispatcher can then claim and wake exactly one
+ * idle worker with @ref tparkIdleSetWakeOne without scanning the workers' handles.
+ */
+typedef struct tpark_idle_set_t tpark_idle_set_t;
+
+/**
+ * @brief Create a new idle-worker set.
+ *
+ * @param capacity Maximum number of workers; worker indices range from 0 to capacity - 1.
+ * @return Pointer to a newly allocated tpark_idle_set_t on success,
+ *         or NULL on failure or if `capacity` is 0.
+ */
+THREAD_PARK_EXPORT tpark_idle_set_t *tparkCreateIdleSet(size_t capacity);
+
+/**
+ * @brief Prepare to park a worker and mark it idle (first phase).
+ *
+ * Calls @ref tparkBeginPark on `handle`, then marks the worker as idle in the set.
+ * Like @ref tparkBeginPark, this does not block. After this call the worker must re-check
+ * for pending work, then either call @ref tparkWait with `unlocked = true` or give up on
+ * parking. In both cases it must conclude with @ref tparkIdleSetEndPark.
+ *
+ * Because the worker is marked idle before it re-checks for work, a dispatcher that
+ * publishes work and then calls @ref tparkIdleSetWakeOne cannot miss it.
+ *
+ * @param set    Pointer to the idle-worker set.
+ * @param worker Index of the calling worker.
+ * @param handle The handle the worker is going to park on.
+ */
+THREAD_PARK_EXPORT void tparkIdleSetBeginPark(tpark_idle_set_t *set, size_t worker, tpark_handle_t *handle);
+
+/**
+ * @brief Mark a worker as no longer idle (final phase).
+ *
+ * Removes the worker from the set if it is still marked idle and calls @ref tparkEndPark on `handle`.
+ *
+ * @param set    Pointer to the idle-worker set.
+ * @param worker Index of the calling worker.
+ * @param handle The handle passed to @ref tparkIdleSetBeginPark.
+ */
+THREAD_PARK_EXPORT void tparkIdleSetEndPark(tpark_idle_set_t *set, size_t worker, tpark_handle_t *handle);
+
+/**
+ * @brief Claim and wake one idle worker, whichever.
+ *
+ * Atomically removes one worker from the set and wakes its handle. Concurrent callers
+ * never claim the same worker. If no worker is idle, this call has no effect.
+ * The cost is independent of the number of parked workers; it scans at most `capacity / 64` bitmap words.
+ *
+ * @param set Pointer to the idle-worker set.
+ * @return true if a worker was claimed and woken, false if no worker was idle.
+ * @warning A worker may be claimed just as it gives up on parking by itself (e.g. because it found work).
+ * The worker is already running in that case, so workers must re-check for work before parking again.
+ */
+THREAD_PARK_EXPORT bool tparkIdleSetWakeOne(tpark_idle_set_t *set);
+
+/**
+ * @brief Destroy an existing idle-worker set.
+ *
+ * @param set Pointer to the idle-worker set to destroy.
+ *            Must have been created by @ref tparkCreateIdleSet.
+ */
+THREAD_PARK_EXPORT void tparkDestroyIdleSet(const tpark_idle_set_t *set);
+
+/**
+ * @brief Opaque structure representing a priority-inheritance mutex.
+ *
+ * On Linux the mutex is built on `FUTEX_LOCK_PI` / `FUTEX_UNLOCK_PI`: while a thread is blocked
+ * on the mutex, the kernel boosts the owner to the blocked thread's priority. This bounds the time
+ * a real-time (e.g. `SCHED_FIFO`) thread can be held up by a lower-priority owner that is itself
+ * preempted by medium-priority threads. Uncontended lock and unlock never enter the kernel.
+ *
+ * On other platforms the mutex has the same API and semantics but does not inherit priority.
+ *
+ * The mutex is not recursive, and it must be unlocked by the thread that locked it.
+ */
+typedef struct tpark_pi_mutex_t tpark_pi_mutex_t;
+
+/**
+ * @brief Create a new priority-inheritance mutex.
+ *
+ * A newly created mutex is unlocked.
+ *
+ * @return Pointer to a newly allocated tpark_pi_mutex_t on success,
+ *         or NULL on failure.
+ */
+THREAD_PARK_EXPORT tpark_pi_mutex_t *tparkCreatePiMutex(void);
+
+/**
+ * @brief Lock the mutex, blocking until it is available.
+ *
+ * @param mutex Pointer to the mutex.
+ */
+THREAD_PARK_EXPORT void tparkPiMutexLock(tpark_pi_mutex_t *mutex);
+
+/**
+ * @brief Try to lock the mutex without blocking.
+ *
+ * @param mutex Pointer to the mutex.
+ * @return true if the mutex was locked, false if it is held by another thread.
+ */
+THREAD_PARK_EXPORT bool tparkPiMutexTryLock(tpark_pi_mutex_t *mutex);
+
+/**
+ * @brief Lock the mutex, blocking for at most the specified time.
+ *
+ * The timeout is measured on a monotonic clock, so changes to the wall clock neither shorten nor extend it.
+ *
+ * @param mutex      Pointer to the mutex.
+ * @param timeout_ns Maximum time to block, in nanoseconds, or @ref TPARK_INFINITE.
+ * @return true if the mutex was locked, false if the timeout expired first.
+ */
+THREAD_PARK_EXPORT bool tparkPiMutexTimedLock(tpark_pi_mutex_t *mutex, uint64_t timeout_ns);
+
+/**
+ * @brief Unlock a mutex held by the calling thread.
+ *
+ * @param mutex Pointer to the mutex.
+ */
+THREAD_PARK_EXPORT void tparkPiMutexUnlock(tpark_pi_mutex_t *mutex);
+
+/**
+ * @brief Destroy an existing priority-inheritance mutex.
+ *
+ * @param mutex Pointer to the mutex to destroy.
+ *              Must have been created by @ref tparkCreatePiMutex and must not be held.
+ */
+THREAD_PARK_EXPORT void tparkDestroyPiMutex(const tpark_pi_mutex_t *mutex);
+
+/**
+ * @brief Opaque structure representing a reader-writer lock.
+ *
+ * The lock keeps its reader count distributed over cache-line-padded slots so that
+ * concurrent readers do not contend on a single shared counter. Writers are preferred:
+ * once a writer is waiting, new readers back off until it has released the lock.
+ * Blocked readers and writers are parked through the threadpark backend.
+ */
+typedef struct tpark_rwlock_t tpark_rwlock_t;
+
+/**
+ * @brief Create a new reader-writer lock.
+ *
+ * A newly created lock is unlocked.
+ *
+ * @return Pointer to a newly allocated tpark_rwlock_t on success,
+ *         or NULL on failure.
+ */
+THREAD_PARK_EXPORT tpark_rwlock_t *tparkCreateRwLock(void);
+
+/**
+ * @brief Acquire the lock in shared (read) mode.
+ *
+ * Blocks while a writer holds or is waiting for the lock.
+ * Multiple readers may hold the lock at the same time.
+ *
+ * @param lock Pointer to the reader-writer lock.
+ * @warning The read lock must be released by the same thread that acquired it,
+ * as each thread is bound to one reader slot.
+ */
+THREAD_PARK_EXPORT void tparkRwLockReadLock(tpark_rwlock_t *lock);
+
+/**
+ * @brief Release a shared (read) lock previously acquired by @ref tparkRwLockReadLock.
+ *
+ * @param lock Pointer to the reader-writer lock.
+ */
+THREAD_PARK_EXPORT void tparkRwLockReadUnlock(tpark_rwlock_t *lock);
+
+/**
+ * @brief Acquire the lock in exclusive (write) mode.
+ *
+ * Blocks until no other writer holds the lock and all readers have left.
+ *
+ * @param lock Pointer to the reader-writer lock.
+ */
+THREAD_PARK_EXPORT void tparkRwLockWriteLock(tpark_rwlock_t *lock);
+
+/**
+ * @brief Release an exclusive (write) lock previously acquired by @ref tparkRwLockWriteLock.
+ *
+ * Wakes all readers and writers parked on the lock.
+ *
+ * @param lock Pointer to the reader-writer lock.
+ */
+THREAD_PARK_EXPORT void tparkRwLockWriteUnlock(tpark_rwlock_t *lock);
+
+/**
+ * @brief Destroy an existing reader-writer lock.
+ *
+ * @param lock Pointer to the reader-writer lock to destroy.
+ *             Must have been created by @ref tparkCreateRwLock and must not be held.
+ */
+THREAD_PARK_EXPORT void tparkDestroyRwLock(const tpark_rwlock_t *lock);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,136 @@
+#include "threadpark.h"
+#include "threadpark_numa.h"
+
+#include <cstddef>
+#include <mutex>
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/// Node masks passed to the kernel cover this many nodes (the kernel's CONFIG_NODES_SHIFT maximum)
+static constexpr int MAX_NUMA_NODES = 1024;
+static constexpr int BITS_PER_MASK_WORD = sizeof(unsigned long) * 8;
+
+/// Handles are carved out of chunks of this size, each placed on one node
+static constexpr size_t ARENA_CHUNK_SIZE = 64 * 1024;
+
+/// Slots are cache-line aligned, so that handles in the same arena do not share cache lines
+static constexpr size_t SLOT_ALIGNMENT = 64;
+
+/**
+ * Per-node pool of handle slots. Chunks are never returned to the OS; freed slots are reused.
+ */
+struct numa_arena_t {
+    std::mutex mutex;
+
+    /// Singly-linked list of freed slots, threaded through the slots themselves
+    void *free_list = nullptr;
+
+    /// Unused remainder of the current chunk
+    char *bump = nullptr;
+    char *bump_end = nullptr;
+};
+
+static int query_node_count() {
+    unsigned long mask[MAX_NUMA_NODES / BITS_PER_MASK_WORD]{};
+    // maxnode is one larger than the number of bits in the mask, as the kernel discards the last bit
+    if (syscall(SYS_get_mempolicy, nullptr, mask, MAX_NUMA_NODES + 1, nullptr, MPOL_F_MEMS_ALLOWED) != 0) {
+        // No NUMA support in the kernel, or the call is filtered (e.g. by a container's seccomp profile)
+        return 1;
+    }
+    int count = 1;
+    for (int node = 0; node < MAX_NUMA_NODES; node++) {
+        if (mask[node / BITS_PER_MASK_WORD] & 1UL << node % BITS_PER_MASK_WORD) {
+            count = node + 1;
+        }
+    }
+    return count;
+}
+
+int tpark_numa_node_count() {
+    static const int count = query_node_count();
+    return count;
+}
+
+int tpark_numa_current_node() {
+    if (tpark_numa_node_count() == 1) {
+        return 0;
+    }
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+    return static_cast<int>(node);
+}
+
+int tpark_numa_node_of(const void *address) {
+    if (tpark_numa_node_count() == 1) {
+        return 0;
+    }
+    int node = 0;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return 0;
+    }
+    return node;
+}
+
+static numa_arena_t *arena_of(const int node) {
+    // Never freed, so that handles destroyed during static destruction can still return their slots
+    static numa_arena_t *const arenas = new numa_arena_t[tpark_numa_node_count()];
+    return &arenas[node];
+}
+
+/// Maps a new chunk whose pages will be faulted in on the given node.
+static char *map_chunk(const int node) {
+    void *chunk = mmap(nullptr, ARENA_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (chunk == MAP_FAILED) {
+        return nullptr;
+    }
+    // Preferred rather than bound, so that allocation falls back to other nodes instead of failing
+    // when the node runs out of memory. Must happen before the pages are first touched.
+    unsigned long mask[MAX_NUMA_NODES / BITS_PER_MASK_WORD]{};
+    mask[node / BITS_PER_MASK_WORD] |= 1UL << node % BITS_PER_MASK_WORD;
+    if (syscall(SYS_mbind, chunk, ARENA_CHUNK_SIZE, MPOL_PREFERRED, mask, MAX_NUMA_NODES + 1, 0) != 0) {
+        munmap(chunk, ARENA_CHUNK_SIZE);
+        return nullptr;
+    }
+    return static_cast<char *>(chunk);
+}
+
+void *tpark_numa_alloc_handle(const size_t handle_size, const int node) {
+    // On a single node the heap is as local as it gets, so fall back to it like tparkCreateHandle
+    if (tpark_numa_node_count() == 1 || node < 0 || node >= tpark_numa_node_count()) {
+        return nullptr;
+    }
+    const size_t slot_size = (handle_size + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+
+    numa_arena_t *arena = arena_of(node);
+    std::lock_guard lock(arena->mutex);
+    if (arena->free_list != nullptr) {
+        void *slot = arena->free_list;
+        arena->free_list = *static_cast<void **>(slot);
+        return slot;
+    }
+    if (arena->bump == nullptr || static_cast<size_t>(arena->bump_end - arena->bump) < slot_size) {
+        // The remainder of the previous chunk (less than one slot) is abandoned
+        char *chunk = map_chunk(node);
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+        arena->bump = chunk;
+        arena->bump_end = chunk + ARENA_CHUNK_SIZE;
+    }
+    void *slot = arena->bump;
+    arena->bump += slot_size;
+    return slot;
+}
+
+void tpark_numa_free_handle(void *memory, const int node) {
+    numa_arena_t *arena = arena_of(node);
+    std::lock_guard lock(arena->mutex);
+    *static_cast<void **>(memory) = arena->free_list;
+    arena->free_list = memory;
+}
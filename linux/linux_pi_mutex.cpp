@@ -0,0 +1,120 @@
+#include "threadpark.h"
+#include "threadpark_internal.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Missing from kernel headers older than 5.14; the kernel then reports ENOSYS at runtime
+#ifndef FUTEX_LOCK_PI2_PRIVATE
+#define FUTEX_LOCK_PI2_PRIVATE (13 | FUTEX_PRIVATE_FLAG)
+#endif
+
+struct tpark_pi_mutex_t {
+    /// The futex word, following the kernel's PI futex protocol:
+    ///  - 0 => unlocked
+    ///  - TID of the owner => locked; the kernel may additionally set FUTEX_WAITERS / FUTEX_OWNER_DIED
+    std::atomic<uint32_t> word{0};
+};
+
+static uint32_t current_tid() {
+    thread_local const auto tid = static_cast<uint32_t>(syscall(SYS_gettid));
+    return tid;
+}
+
+/// Whether the kernel supports FUTEX_LOCK_PI2 (Linux 5.14+); cleared by the first call that fails with ENOSYS
+static std::atomic<bool> lock_pi2_supported{true};
+
+/// Returns the absolute time on `clock` that lies `remaining` from now.
+static timespec deadline_on(const clockid_t clock, const std::chrono::nanoseconds remaining) {
+    timespec deadline{};
+    clock_gettime(clock, &deadline);
+    const uint64_t nanos = static_cast<uint64_t>(deadline.tv_nsec) + remaining.count() % 1000000000;
+    deadline.tv_sec += static_cast<time_t>(remaining.count() / 1000000000 + nanos / 1000000000);
+    deadline.tv_nsec = static_cast<long>(nanos % 1000000000);
+    return deadline;
+}
+
+/// Blocks in the kernel until the mutex is acquired or the timeout expires.
+static bool futex_lock_pi(tpark_pi_mutex_t *mutex, const uint64_t timeout_ns) {
+    // The kernel only takes absolute deadlines. The authoritative one is kept on the steady clock, so that an
+    // ETIMEDOUT caused by the wall clock jumping forward (FUTEX_LOCK_PI only) is retried with the remaining time.
+    const bool infinite = timeout_ns > MAX_FINITE_TIMEOUT_NS;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(infinite ? 0 : timeout_ns);
+    while (true) {
+        // FUTEX_LOCK_PI2 measures the deadline on CLOCK_MONOTONIC (the steady clock), FUTEX_LOCK_PI on CLOCK_REALTIME
+        const bool pi2 = lock_pi2_supported.load(std::memory_order_relaxed);
+        timespec kernel_deadline{};
+        if (!infinite) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                return false;
+            }
+            kernel_deadline = deadline_on(pi2 ? CLOCK_MONOTONIC : CLOCK_REALTIME, deadline - now);
+        }
+        if (syscall(SYS_futex, reinterpret_cast<uint32_t *>(&mutex->word),
+                    pi2 ? FUTEX_LOCK_PI2_PRIVATE : FUTEX_LOCK_PI_PRIVATE, 0,
+                    infinite ? nullptr : &kernel_deadline, nullptr, 0) == 0) {
+            return true;
+        }
+        if (errno == ENOSYS && pi2) {
+            // Kernel older than 5.14; fall back to FUTEX_LOCK_PI
+            lock_pi2_supported.store(false, std::memory_order_relaxed);
+            continue;
+        }
+        if (errno == ETIMEDOUT || errno == EINTR || errno == EAGAIN) {
+            // Timed out (the steady deadline decides whether for real), interrupted by a signal,
+            // or the owner is exiting; retry
+            continue;
+        }
+        std::cerr << "Unexpected error in tparkPiMutexLock: " << std::strerror(errno) << std::endl;
+        std::abort();
+    }
+}
+
+tpark_pi_mutex_t *tparkCreatePiMutex() { return new tpark_pi_mutex_t(); }
+
+void tparkPiMutexLock(tpark_pi_mutex_t *mutex) {
+    // Fast path: uncontended lock without entering the kernel
+    if (uint32_t expected = 0; mutex->word.compare_exchange_strong(expected, current_tid(),
+                                                                    std::memory_order_acquire)) {
+        return;
+    }
+    futex_lock_pi(mutex, TPARK_INFINITE);
+}
+
+bool tparkPiMutexTryLock(tpark_pi_mutex_t *mutex) {
+    uint32_t expected = 0;
+    return mutex->word.compare_exchange_strong(expected, current_tid(), std::memory_order_acquire);
+}
+
+bool tparkPiMutexTimedLock(tpark_pi_mutex_t *mutex, const uint64_t timeout_ns) {
+    if (tparkPiMutexTryLock(mutex)) {
+        return true;
+    }
+    return futex_lock_pi(mutex, timeout_ns);
+}
+
+void tparkPiMutexUnlock(tpark_pi_mutex_t *mutex) {
+    // Fast path: no waiters, so the word still holds exactly our TID
+    if (uint32_t expected = current_tid(); mutex->word.compare_exchange_strong(expected, 0,
+                                                                                std::memory_order_release)) {
+        return;
+    }
+    // FUTEX_WAITERS is set; the kernel hands the mutex to the highest-priority waiter
+    if (syscall(SYS_futex, reinterpret_cast<uint32_t *>(&mutex->word), FUTEX_UNLOCK_PI_PRIVATE, 0,
+                nullptr, nullptr, 0) != 0) {
+        std::cerr << "Unexpected error in tparkPiMutexUnlock: " << std::strerror(errno) << std::endl;
+        std::abort();
+    }
+}
+
+void tparkDestroyPiMutex(const tpark_pi_mutex_t *mutex) { delete mutex; }
@@ -1,8 +1,14 @@
 #include "threadpark.h"
+#include "threadpark_cancel.h"
+#include "threadpark_internal.h"
+#include "threadpark_numa.h"
+#include "threadpark_registry.h"
 
 #include <atomic>
 #include <cerrno>
+#include <climits>
 #include <cstring>
+#include <ctime>
 #include <iostream>
 
 #include <linux/futex.h>
@@ -14,8 +20,20 @@ struct tpark_handle_t {
     ///  - 1 => "thread is parked / should block"
     ///  - 0 => "thread is not parked / free to proceed"
     std::atomic<int> state{0};
+
+    /// Cancellation token the handle is associated with, if any
+    tpark_cancel_link_t cancel;
+
+    /// NUMA node and origin of the handle's memory
+    tpark_numa_placement_t numa;
+
+    TPARK_REGISTRY_ENTRY
 };
 
+tpark_cancel_link_t *tpark_cancel_link(tpark_handle_t *handle) { return &handle->cancel; }
+
+TPARK_REGISTRY_ENTRY_ACCESSOR
+
 static int futex_wait(std::atomic<int> *addr, int expected) {
     return syscall(SYS_futex, reinterpret_cast<int *>(addr), FUTEX_WAIT, expected,
                    nullptr, // no timeout
@@ -30,30 +48,43 @@ static int futex_wake(std::atomic<int> *addr, int num_wakes) {
                    0);
 }
 
-tpark_handle_t *tparkCreateHandle() { return new tpark_handle_t(); }
+tpark_handle_t *tparkCreateHandle() { return tparkCreateHandleOnNode(TPARK_NODE_ANY); }
+
+tpark_handle_t *tparkCreateHandleOnNode(const int node) {
+    auto *handle = tpark_numa_new<tpark_handle_t>(node);
+    TPARK_REGISTRY_ADD(handle);
+    return handle;
+}
 
-void tparkWait(tpark_handle_t *handle, const bool unlocked) {
+tpark_wait_result_t tparkWait(tpark_handle_t *handle, const bool unlocked) {
     if (!unlocked) {
+        TPARK_REGISTRY_ON_PARK(handle);
         // Indicate we want to park
         handle->state.store(1, std::memory_order_seq_cst);
     }
     while (true) {
         // Double-check the state before actually blocking
-        if (handle->state.load(std::memory_order_seq_cst) != 1) {
+        if (handle->state.load(std::memory_order_acquire) != 1) {
             // If it's not 1 anymore, we're done (another thread likely called wake).
-            return;
+            return tpark_cancel_wait_result(&handle->cancel);
+        }
+        // Checked after setting the park bit, so that a concurrent tparkCancel either sees us parked or is seen here
+        if (tpark_cancel_requested(&handle->cancel)) {
+            tparkEndPark(handle);
+            return TPARK_WAIT_CANCELLED;
         }
 
         // Otherwise, do a futex wait for the value 1
         if (const int rc = futex_wait(&handle->state, 1); rc == 0) {
-            // We were woken up, so presumably the state is now 0. We return.
-            return;
+            // We were woken up, but possibly by a late wake from a previous park episode.
+            // Let the acquire re-check at the top of the loop decide whether the park bit was cleared.
+            continue;
         } else {
             // rc < 0 => check errno
             if (errno == EAGAIN) {
                 // check for spurious wakeups
-                if (handle->state.load(std::memory_order_seq_cst) != 1) {
-                    return;
+                if (handle->state.load(std::memory_order_acquire) != 1) {
+                    return tpark_cancel_wait_result(&handle->cancel);
                 }
             } else if (errno == EINTR) {
                 // Interrupted by a signal; retry
@@ -66,29 +97,81 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
     }
 }
 
-void tparkBeginPark(tpark_handle_t *handle) {
-    handle->state.exchange(1, std::memory_order_seq_cst);
+void tparkBeginPark(tpark_handle_t *handle) { tparkBeginParkExplicit(handle, TPARK_ORDER_SEQ_CST); }
+
+void tparkBeginParkExplicit(tpark_handle_t *handle, const tpark_memory_order_t order) {
+    TPARK_REGISTRY_ON_PARK(handle);
+    handle->state.store(1, tpark_park_order(order));
 }
 
 void tparkEndPark(tpark_handle_t *handle) {
-    handle->state.store(0, std::memory_order_seq_cst);
+    // Relaxed: a waker that observes 0 merely skips a wake this thread no longer waits for.
+    // The next tparkBeginPark re-establishes the ordering needed to park again.
+    handle->state.store(0, std::memory_order_relaxed);
 }
 
-void tparkWake(tpark_handle_t *handle) {
-    if (handle->state.load(std::memory_order_seq_cst) == 0) {
+void tparkWake(tpark_handle_t *handle) { tparkWakeExplicit(handle, TPARK_ORDER_SEQ_CST); }
+
+void tparkWakeExplicit(tpark_handle_t *handle, const tpark_memory_order_t order) {
+    if (handle->state.load(tpark_wake_check_order(order)) == 0) {
         // No need to wake up, the thread is not parked
         return;
     }
+    TPARK_REGISTRY_ON_WAKE(handle);
 
     // Set the state to 0 => unpark
-    handle->state.store(0, std::memory_order_seq_cst);
+    // Release, so that the woken thread observes everything we wrote before waking it.
+    handle->state.store(0, std::memory_order_release);
 
     // Wake one thread waiting on the futex
     futex_wake(&handle->state, 1);
 }
 
 bool tparkIsParked(const tpark_handle_t *handle) {
-    return handle->state.load(std::memory_order_seq_cst) == 1;
+    return handle->state.load(std::memory_order_acquire) == 1;
+}
+
+void *tpark_park_word(tpark_handle_t *handle) { return &handle->state; }
+
+bool tpark_abandon_park(tpark_handle_t *handle) {
+    int expected = 1;
+    return handle->state.compare_exchange_strong(expected, 0, std::memory_order_acquire);
 }
 
-void tparkDestroyHandle(const tpark_handle_t *handle) { delete handle; }
+void tparkDestroyHandle(const tpark_handle_t *handle) {
+    tpark_cancel_detach(&handle->cancel, handle);
+    TPARK_REGISTRY_REMOVE(handle);
+    tpark_numa_delete(handle);
+}
+
+int tparkHandleNode(const tpark_handle_t *handle) { return tpark_numa_handle_node(handle); }
+
+tpark_wait_result_t tparkWaitOnAddress(void *addr, const uint32_t expected, const uint64_t timeout_ns) {
+    timespec timeout{};
+    const timespec *timeout_ptr = nullptr;
+    if (timeout_ns != TPARK_INFINITE) {
+        timeout.tv_sec = static_cast<time_t>(timeout_ns / 1000000000);
+        timeout.tv_nsec = static_cast<long>(timeout_ns % 1000000000);
+        timeout_ptr = &timeout;
+    }
+    if (syscall(SYS_futex, static_cast<uint32_t *>(addr), FUTEX_WAIT, expected, timeout_ptr, nullptr, 0) != 0) {
+        if (errno == ETIMEDOUT) {
+            return TPARK_WAIT_TIMED_OUT;
+        }
+        // EAGAIN => value already changed; EINTR => signal. Both are treated as spurious wakeups.
+        if (errno != EAGAIN && errno != EINTR) {
+            std::cerr << "Unexpected error in tparkWaitOnAddress: " << std::strerror(errno) << std::endl;
+            std::abort();
+        }
+    }
+    return TPARK_WAIT_WOKEN;
+}
+
+void tparkWakeAddress(void *addr, const uint32_t count) {
+    // FUTEX_WAKE with a count of 0 still wakes one waiter, so 0 must not reach the kernel
+    if (count == 0) {
+        return;
+    }
+    syscall(SYS_futex, static_cast<uint32_t *>(addr), FUTEX_WAKE,
+            count > INT_MAX ? INT_MAX : static_cast<int>(count), nullptr, nullptr, 0);
+}
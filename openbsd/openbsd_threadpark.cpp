@@ -1,9 +1,15 @@
 #include "threadpark.h"
+#include "threadpark_cancel.h"
+#include "threadpark_internal.h"
+#include "threadpark_numa.h"
+#include "threadpark_registry.h"
 
 #include <iostream>
 #include <atomic>
 #include <cstdint>
 #include <cerrno>
+#include <climits>
+#include <cstring>
 
 #include <sys/futex.h>
 #include <sys/time.h>
@@ -13,14 +19,31 @@ struct tpark_handle_t {
     // 0 => not parked
     // 1 => parked
     std::atomic<uint32_t> state{0};
+
+    /// Cancellation token the handle is associated with, if any
+    tpark_cancel_link_t cancel;
+
+    /// NUMA node and origin of the handle's memory
+    tpark_numa_placement_t numa;
+
+    TPARK_REGISTRY_ENTRY
 };
 
-tpark_handle_t* tparkCreateHandle() {
-    return new tpark_handle_t();
+tpark_cancel_link_t *tpark_cancel_link(tpark_handle_t *handle) { return &handle->cancel; }
+
+TPARK_REGISTRY_ENTRY_ACCESSOR
+
+tpark_handle_t* tparkCreateHandle() { return tparkCreateHandleOnNode(TPARK_NODE_ANY); }
+
+tpark_handle_t* tparkCreateHandleOnNode(const int node) {
+    auto *handle = tpark_numa_new<tpark_handle_t>(node);
+    TPARK_REGISTRY_ADD(handle);
+    return handle;
 }
 
-void tparkWait(tpark_handle_t *handle, const bool unlocked) {
+tpark_wait_result_t tparkWait(tpark_handle_t *handle, const bool unlocked) {
     if (!unlocked) {
+        TPARK_REGISTRY_ON_PARK(handle);
         // Set the state to 1 to indicate we want to park
         handle->state.store(1, std::memory_order_seq_cst);
     }
@@ -28,9 +51,14 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
 
     while (true) {
         // Double-check the state before actually blocking
-        if (handle->state.load(std::memory_order_seq_cst) != 1) {
+        if (handle->state.load(std::memory_order_acquire) != 1) {
             // If it's not 1 anymore, we're done (another thread likely called wake).
-            return;
+            return tpark_cancel_wait_result(&handle->cancel);
+        }
+        // Checked after setting the park bit, so that a concurrent tparkCancel either sees us parked or is seen here
+        if (tpark_cancel_requested(&handle->cancel)) {
+            tparkEndPark(handle);
+            return TPARK_WAIT_CANCELLED;
         }
 
         // The futex call wants (volatile uint32_t *) rather than (std::atomic<uint32_t>*).
@@ -43,14 +71,15 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
                        nullptr);    // not used for FUTEX_WAIT
 
         if (rc == 0) {
-            // Woken by FUTEX_WAKE
-            return;
+            // Woken by FUTEX_WAKE, possibly a late one from a previous park episode.
+            // Let the acquire re-check at the top of the loop decide.
+            continue;
         } else {
             // rc == -1 => check errno
             if (errno == EAGAIN) {
                 // check for spurious wakeups
-                if (handle->state.load(std::memory_order_seq_cst) != 1) {
-                    return;
+                if (handle->state.load(std::memory_order_acquire) != 1) {
+                    return tpark_cancel_wait_result(&handle->cancel);
                 }
             } else if (errno == EINTR) {
                 // Interrupted by a signal => retry
@@ -63,18 +92,31 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
     }
 }
 
-void tparkBeginPark(tpark_handle_t *handle) { handle->state.store(1, std::memory_order_seq_cst); }
+void tparkBeginPark(tpark_handle_t *handle) { tparkBeginParkExplicit(handle, TPARK_ORDER_SEQ_CST); }
 
-void tparkEndPark(tpark_handle_t *handle) { handle->state.store(0, std::memory_order_seq_cst); }
+void tparkBeginParkExplicit(tpark_handle_t *handle, const tpark_memory_order_t order) {
+    TPARK_REGISTRY_ON_PARK(handle);
+    handle->state.store(1, tpark_park_order(order));
+}
+
+void tparkEndPark(tpark_handle_t *handle) {
+    // Relaxed: a waker that observes 0 merely skips a wake this thread no longer waits for.
+    // The next tparkBeginPark re-establishes the ordering needed to park again.
+    handle->state.store(0, std::memory_order_relaxed);
+}
 
-void tparkWake(tpark_handle_t* handle) {
-    if (handle->state.load(std::memory_order_acquire) == 0) {
+void tparkWake(tpark_handle_t *handle) { tparkWakeExplicit(handle, TPARK_ORDER_SEQ_CST); }
+
+void tparkWakeExplicit(tpark_handle_t *handle, const tpark_memory_order_t order) {
+    if (handle->state.load(tpark_wake_check_order(order)) == 0) {
         // No need to wake up, the thread is not parked
         return;
     }
+    TPARK_REGISTRY_ON_WAKE(handle);
 
     // Unpark
-    handle->state.store(0, std::memory_order_seq_cst);
+    // Release, so that the woken thread observes everything we wrote before waking it.
+    handle->state.store(0, std::memory_order_release);
 
     // The futex call wants (volatile uint32_t *).
     volatile uint32_t *addr = reinterpret_cast<volatile uint32_t*>(&handle->state);
@@ -88,9 +130,51 @@ void tparkWake(tpark_handle_t* handle) {
 }
 
 bool tparkIsParked(const tpark_handle_t *handle) {
-    return handle->state.load(std::memory_order_seq_cst) == 1;
+    return handle->state.load(std::memory_order_acquire) == 1;
+}
+
+void *tpark_park_word(tpark_handle_t *handle) { return &handle->state; }
+
+bool tpark_abandon_park(tpark_handle_t *handle) {
+    uint32_t expected = 1;
+    return handle->state.compare_exchange_strong(expected, 0, std::memory_order_acquire);
 }
 
 void tparkDestroyHandle(const tpark_handle_t* handle) {
-    delete handle;
+    tpark_cancel_detach(&handle->cancel, handle);
+    TPARK_REGISTRY_REMOVE(handle);
+    tpark_numa_delete(handle);
+}
+
+int tparkHandleNode(const tpark_handle_t *handle) { return tpark_numa_handle_node(handle); }
+
+tpark_wait_result_t tparkWaitOnAddress(void *addr, const uint32_t expected, const uint64_t timeout_ns) {
+    timespec timeout{};
+    const timespec *timeout_ptr = nullptr;
+    if (timeout_ns != TPARK_INFINITE) {
+        timeout.tv_sec = static_cast<time_t>(timeout_ns / 1000000000);
+        timeout.tv_nsec = static_cast<long>(timeout_ns % 1000000000);
+        timeout_ptr = &timeout;
+    }
+    volatile uint32_t *uaddr = static_cast<volatile uint32_t *>(addr);
+    if (futex(uaddr, FUTEX_WAIT, static_cast<int>(expected), timeout_ptr, nullptr) != 0) {
+        if (errno == ETIMEDOUT) {
+            return TPARK_WAIT_TIMED_OUT;
+        }
+        // EAGAIN => value already changed; EINTR => signal. Both are treated as spurious wakeups.
+        if (errno != EAGAIN && errno != EINTR) {
+            std::cerr << "Unexpected error in tparkWaitOnAddress: " << std::strerror(errno) << std::endl;
+            std::abort();
+        }
+    }
+    return TPARK_WAIT_WOKEN;
+}
+
+void tparkWakeAddress(void *addr, const uint32_t count) {
+    // A count of 0 wakes no one on every backend, whatever the kernel makes of it
+    if (count == 0) {
+        return;
+    }
+    volatile uint32_t *uaddr = static_cast<volatile uint32_t *>(addr);
+    futex(uaddr, FUTEX_WAKE, count > INT_MAX ? INT_MAX : static_cast<int>(count), nullptr, nullptr);
 }
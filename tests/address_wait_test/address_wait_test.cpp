@@ -0,0 +1,115 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static constexpr int NUM_WAITERS = 4;
+static constexpr auto TIMEOUT = std::chrono::milliseconds(100);
+
+static uint64_t toNanos(const std::chrono::nanoseconds duration) { return duration.count(); }
+
+int main() {
+    std::atomic<uint32_t> word{0};
+
+    // 1) Value mismatch => returns immediately
+    if (tparkWaitOnAddress(&word, 1, TPARK_INFINITE) != TPARK_WAIT_WOKEN) {
+        std::cerr << "TEST FAILED: Wait with a stale expected value did not return immediately.\n";
+        return EXIT_FAILURE;
+    }
+
+    // 2) Nobody wakes us => times out, but not early
+    {
+        const auto start = std::chrono::steady_clock::now();
+        tpark_wait_result_t result = TPARK_WAIT_WOKEN;
+        while (std::chrono::steady_clock::now() - start < TIMEOUT && result != TPARK_WAIT_TIMED_OUT) {
+            result = tparkWaitOnAddress(&word, 0, toNanos(TIMEOUT));
+        }
+        if (result != TPARK_WAIT_TIMED_OUT || std::chrono::steady_clock::now() - start < TIMEOUT) {
+            std::cerr << "TEST FAILED: Timed wait did not time out as expected.\n";
+            return EXIT_FAILURE;
+        }
+        if (tparkWaitOnAddress(&word, 0, 0) != TPARK_WAIT_TIMED_OUT) {
+            std::cerr << "TEST FAILED: Zero timeout did not time out.\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    // 3) A wake count of 0 wakes no one
+    {
+        tpark_wait_result_t result = TPARK_WAIT_WOKEN;
+        std::thread waiter([&] { result = tparkWaitOnAddress(&word, 0, toNanos(TIMEOUT)); });
+        std::this_thread::sleep_for(TIMEOUT / 4);
+        tparkWakeAddress(&word, 0);
+        waiter.join();
+        if (result != TPARK_WAIT_TIMED_OUT) {
+            std::cerr << "TEST FAILED: Waking with a count of 0 woke a waiter.\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    // 4) Store + wake from another thread releases every waiter
+    {
+        std::atomic g_released{0};
+        std::vector<std::thread> waiters;
+        for (int i = 0; i < NUM_WAITERS; i++) {
+            waiters.emplace_back([&] {
+                while (word.load() == 0) {
+                    tparkWaitOnAddress(&word, 0, TPARK_INFINITE);
+                }
+                g_released.fetch_add(1);
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        word.store(1);
+        tparkWakeAddress(&word, TPARK_WAKE_ALL);
+        for (std::thread &waiter: waiters) {
+            waiter.join();
+        }
+        if (g_released.load() != NUM_WAITERS) {
+            std::cerr << "TEST FAILED: Not all waiters were released.\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    // 5) Waking one waiter at a time
+    {
+        std::atomic<uint32_t> tickets{0};
+        std::atomic g_released{0};
+        std::vector<std::thread> waiters;
+        for (int i = 0; i < NUM_WAITERS; i++) {
+            waiters.emplace_back([&] {
+                // Take a ticket once one is available
+                while (true) {
+                    uint32_t available = tickets.load();
+                    if (available != 0) {
+                        if (tickets.compare_exchange_weak(available, available - 1)) {
+                            break;
+                        }
+                        continue;
+                    }
+                    tparkWaitOnAddress(&tickets, 0, TPARK_INFINITE);
+                }
+                g_released.fetch_add(1);
+            });
+        }
+        for (int i = 0; i < NUM_WAITERS; i++) {
+            tickets.fetch_add(1);
+            tparkWakeAddress(&tickets, 1);
+        }
+        for (std::thread &waiter: waiters) {
+            waiter.join();
+        }
+        if (g_released.load() != NUM_WAITERS) {
+            std::cerr << "TEST FAILED: Not all ticket holders were released.\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << "TEST PASSED: Address waits time out, observe value changes and wake.\n";
+    return EXIT_SUCCESS;
+}
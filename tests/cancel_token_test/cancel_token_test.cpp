@@ -0,0 +1,178 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static constexpr int NUM_WAITERS = 8;
+static constexpr int NUM_RACE_ITERATIONS = 1000;
+static constexpr auto TIMEOUT = std::chrono::milliseconds(50);
+
+/// Upper bound for how long a bulk cancellation may take to drain all waiters
+static constexpr auto MAX_DRAIN_TIME = std::chrono::seconds(5);
+
+static constexpr uint64_t toNanos(const std::chrono::milliseconds duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+/// Parks several threads under one token and checks that a single cancel wakes all of them.
+static bool testBulkCancel() {
+    tpark_cancel_token_t *token = tparkCreateCancelToken();
+    std::vector<tpark_handle_t *> handles;
+    for (int i = 0; i < NUM_WAITERS; i++) {
+        handles.push_back(tparkCreateHandle());
+        tparkSetCancelToken(handles.back(), token);
+        tparkBeginPark(handles.back());
+    }
+
+    std::atomic numCancelled{0};
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < NUM_WAITERS; i++) {
+        waiters.emplace_back([&, i] {
+            // Half of the waiters use a timeout far longer than the test
+            const tpark_wait_result_t result = i % 2 == 0
+                                                   ? tparkWait(handles[i], true)
+                                                   : tparkTimedWait(handles[i], true, toNanos(std::chrono::hours(1)));
+            if (result == TPARK_WAIT_CANCELLED) {
+                numCancelled.fetch_add(1);
+            }
+        });
+    }
+
+    // Give the waiters a chance to actually block before cancelling
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto start = std::chrono::steady_clock::now();
+    tparkCancel(token);
+    for (std::thread &waiter: waiters) {
+        waiter.join();
+    }
+    const auto drainTime = std::chrono::steady_clock::now() - start;
+
+    for (const tpark_handle_t *handle: handles) {
+        tparkDestroyHandle(handle);
+    }
+    tparkDestroyCancelToken(token);
+
+    if (numCancelled.load() != NUM_WAITERS) {
+        std::cerr << "Only " << numCancelled.load() << " of " << NUM_WAITERS << " waiters reported cancellation"
+                << std::endl;
+        return false;
+    }
+    if (drainTime > MAX_DRAIN_TIME) {
+        std::cerr << "Draining the waiters took too long" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// Waits that start after cancellation must return immediately.
+static bool testWaitAfterCancel() {
+    tpark_cancel_token_t *token = tparkCreateCancelToken();
+    tpark_handle_t *handle = tparkCreateHandle();
+    tparkSetCancelToken(handle, token);
+    tparkCancel(token);
+
+    bool ok = tparkIsCancelled(token);
+    ok &= tparkWait(handle, false) == TPARK_WAIT_CANCELLED;
+    ok &= tparkTimedWait(handle, false, toNanos(std::chrono::hours(1))) == TPARK_WAIT_CANCELLED;
+    ok &= !tparkIsParked(handle);
+
+    // Detaching the handle makes it usable again
+    tparkSetCancelToken(handle, nullptr);
+    ok &= tparkTimedWait(handle, false, 0) == TPARK_WAIT_TIMED_OUT;
+
+    tparkDestroyHandle(handle);
+    tparkDestroyCancelToken(token);
+    if (!ok) {
+        std::cerr << "Wait after cancellation did not return cancelled" << std::endl;
+    }
+    return ok;
+}
+
+/// Timed waits report whether they were woken or timed out.
+static bool testTimedWait() {
+    tpark_handle_t *handle = tparkCreateHandle();
+    bool ok = true;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (tparkTimedWait(handle, false, toNanos(TIMEOUT)) != TPARK_WAIT_TIMED_OUT) {
+        std::cerr << "Timed wait without a waker did not time out" << std::endl;
+        ok = false;
+    } else if (std::chrono::steady_clock::now() - start < TIMEOUT) {
+        std::cerr << "Timed wait timed out early" << std::endl;
+        ok = false;
+    }
+    if (tparkIsParked(handle)) {
+        std::cerr << "Timed out wait left the park bit set" << std::endl;
+        ok = false;
+    }
+
+    tparkBeginPark(handle);
+    std::thread waker([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        tparkWake(handle);
+    });
+    if (tparkTimedWait(handle, true, toNanos(std::chrono::hours(1))) != TPARK_WAIT_WOKEN) {
+        std::cerr << "Woken timed wait did not report a wake" << std::endl;
+        ok = false;
+    }
+    waker.join();
+
+    tparkDestroyHandle(handle);
+    return ok;
+}
+
+/// Cancels while the waiter is in the middle of parking; a missed cancellation hangs the join.
+static bool testCancelRace() {
+    tpark_handle_t *handle = tparkCreateHandle();
+    for (int i = 0; i < NUM_RACE_ITERATIONS; i++) {
+        tpark_cancel_token_t *token = tparkCreateCancelToken();
+        tparkSetCancelToken(handle, token);
+
+        std::thread waiter([&] {
+            while (tparkWait(handle, false) != TPARK_WAIT_CANCELLED) {
+            }
+        });
+        tparkCancel(token);
+        waiter.join();
+
+        tparkSetCancelToken(handle, nullptr);
+        tparkDestroyCancelToken(token);
+    }
+    tparkDestroyHandle(handle);
+    return true;
+}
+
+/// Destroying a handle detaches it, so cancelling the token afterwards must not touch it.
+static bool testDestroyDetaches() {
+    tpark_cancel_token_t *token = tparkCreateCancelToken();
+    tpark_handle_t *first = tparkCreateHandle();
+    tpark_handle_t *second = tparkCreateHandle();
+    tparkSetCancelToken(first, token);
+    tparkSetCancelToken(second, token);
+    tparkDestroyHandle(first);
+
+    tparkBeginPark(second);
+    tparkCancel(token);
+    const bool ok = !tparkIsParked(second);
+
+    tparkDestroyHandle(second);
+    tparkDestroyCancelToken(token);
+    if (!ok) {
+        std::cerr << "Cancel did not wake the remaining handle" << std::endl;
+    }
+    return ok;
+}
+
+int main() {
+    if (!testBulkCancel() || !testWaitAfterCancel() || !testTimedWait() || !testCancelRace() ||
+        !testDestroyDetaches()) {
+        std::cerr << "TEST FAILED: Cancellation tokens misbehaved.\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "TEST PASSED: Cancellation woke all parked threads and waits reported why they returned.\n";
+    return EXIT_SUCCESS;
+}
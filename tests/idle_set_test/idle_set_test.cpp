@@ -0,0 +1,102 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static constexpr int NUM_WORKERS = 70; // spans more than one bitmap word
+static constexpr int NUM_TASKS = 5000;
+static constexpr auto MAX_DRAIN_TIME = std::chrono::seconds(10);
+
+/// Tasks published by the dispatcher but not yet claimed by a worker
+static std::atomic g_pendingTasks{0};
+static std::atomic g_completedTasks{0};
+static std::atomic g_stop{false};
+
+static bool tryClaimTask() {
+    int pending = g_pendingTasks.load();
+    while (pending > 0) {
+        if (g_pendingTasks.compare_exchange_weak(pending, pending - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main() {
+    // A single worker: claimed exactly once, and waking an empty set is a no-op
+    {
+        tpark_idle_set_t *set = tparkCreateIdleSet(1);
+        tpark_handle_t *handle = tparkCreateHandle();
+        if (tparkIdleSetWakeOne(set)) {
+            std::cerr << "TEST FAILED: Woke a worker in an empty idle set.\n";
+            return EXIT_FAILURE;
+        }
+        tparkIdleSetBeginPark(set, 0, handle);
+        if (!tparkIdleSetWakeOne(set) || tparkIsParked(handle) || tparkIdleSetWakeOne(set)) {
+            std::cerr << "TEST FAILED: Idle worker was not claimed exactly once.\n";
+            return EXIT_FAILURE;
+        }
+        tparkIdleSetEndPark(set, 0, handle);
+        tparkDestroyHandle(handle);
+        tparkDestroyIdleSet(set);
+    }
+
+    tpark_idle_set_t *set = tparkCreateIdleSet(NUM_WORKERS);
+    std::vector<tpark_handle_t *> handles;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < NUM_WORKERS; i++) {
+        handles.push_back(tparkCreateHandle());
+    }
+    for (int i = 0; i < NUM_WORKERS; i++) {
+        workers.emplace_back([&, i] {
+            while (!g_stop.load()) {
+                tparkIdleSetBeginPark(set, i, handles[i]);
+
+                // Re-check for work after announcing ourselves as idle
+                if (!tryClaimTask() && !g_stop.load()) {
+                    tparkWait(handles[i], true);
+                    tparkIdleSetEndPark(set, i, handles[i]);
+                    continue;
+                }
+                tparkIdleSetEndPark(set, i, handles[i]);
+                g_completedTasks.fetch_add(1);
+            }
+        });
+    }
+
+    // Dispatcher: publish one task at a time and wake whichever worker is idle
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_TASKS; i++) {
+        g_pendingTasks.fetch_add(1);
+        tparkIdleSetWakeOne(set);
+    }
+    while (g_completedTasks.load() != NUM_TASKS &&
+           std::chrono::steady_clock::now() - start < MAX_DRAIN_TIME) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const bool drained = g_completedTasks.load() == NUM_TASKS;
+
+    g_stop.store(true);
+    for (tpark_handle_t *handle: handles) {
+        tparkWake(handle);
+    }
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+    for (const tpark_handle_t *handle: handles) {
+        tparkDestroyHandle(handle);
+    }
+    tparkDestroyIdleSet(set);
+
+    if (!drained) {
+        std::cerr << "TEST FAILED: Only " << g_completedTasks.load() << " of " << NUM_TASKS
+                << " tasks completed. Potential lost wake.\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "TEST PASSED: " << NUM_TASKS << " tasks dispatched to " << NUM_WORKERS << " workers.\n";
+    return EXIT_SUCCESS;
+}
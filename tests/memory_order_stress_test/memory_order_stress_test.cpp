@@ -0,0 +1,96 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+static constexpr int NUM_ITERATIONS = 100000; // handshakes per memory ordering
+static constexpr auto MAX_STALL = std::chrono::seconds(5); // no progress for this long => lost wake
+
+/// Number of completed handshakes, watched by the stall detector
+static std::atomic g_progress{0};
+
+/// Parks on `handle` until `counter` reaches `target`, using the two-phase park with the given ordering.
+static void parkUntil(tpark_handle_t *handle, const std::atomic<int> &counter, const int target,
+                      const tpark_memory_order_t order) {
+    while (counter.load(std::memory_order_acquire) < target) {
+        tparkBeginParkExplicit(handle, order);
+        if (order == TPARK_ORDER_ACQ_REL) {
+            // The caller-supplied fence between setting the park bit and re-checking the condition
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        if (counter.load(std::memory_order_relaxed) < target) {
+            tparkWait(handle, true);
+        }
+        tparkEndPark(handle);
+    }
+}
+
+/// Publishes `value` to `counter`, then wakes the thread parked on `handle` with the given ordering.
+static void publishAndWake(tpark_handle_t *handle, std::atomic<int> &counter, const int value,
+                           const tpark_memory_order_t order) {
+    if (order == TPARK_ORDER_ACQ_REL) {
+        counter.store(value, std::memory_order_release);
+        // The caller-supplied fence between publishing and checking the park bit
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    } else {
+        counter.store(value, std::memory_order_seq_cst);
+    }
+    tparkWakeExplicit(handle, order);
+}
+
+/// Ping-pongs NUM_ITERATIONS times between two threads that both park and wake with the given ordering.
+static void runHandshakes(const tpark_memory_order_t order) {
+    tpark_handle_t *producerHandle = tparkCreateHandle();
+    tpark_handle_t *consumerHandle = tparkCreateHandle();
+    std::atomic produced{0};
+    std::atomic consumed{0};
+
+    std::thread consumer([&] {
+        for (int i = 1; i <= NUM_ITERATIONS; i++) {
+            parkUntil(consumerHandle, produced, i, order);
+            publishAndWake(producerHandle, consumed, i, order);
+        }
+    });
+    for (int i = 1; i <= NUM_ITERATIONS; i++) {
+        publishAndWake(consumerHandle, produced, i, order);
+        parkUntil(producerHandle, consumed, i, order);
+        g_progress.fetch_add(1, std::memory_order_relaxed);
+    }
+    consumer.join();
+
+    tparkDestroyHandle(producerHandle);
+    tparkDestroyHandle(consumerHandle);
+}
+
+int main() {
+    std::atomic done{false};
+
+    // A lost wake makes both threads block forever, so detect missing progress from the outside
+    std::thread stallDetector([&] {
+        int lastProgress = -1;
+        auto lastChange = std::chrono::steady_clock::now();
+        while (!done.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            if (const int progress = g_progress.load(); progress != lastProgress) {
+                lastProgress = progress;
+                lastChange = std::chrono::steady_clock::now();
+            } else if (std::chrono::steady_clock::now() - lastChange > MAX_STALL) {
+                std::cerr << "TEST FAILED: No progress after " << progress << " handshakes. Lost wake.\n";
+                std::_Exit(EXIT_FAILURE);
+            }
+        }
+    });
+
+    runHandshakes(TPARK_ORDER_SEQ_CST);
+    runHandshakes(TPARK_ORDER_ACQ_REL);
+
+    done.store(true);
+    stallDetector.join();
+
+    std::cout << "TEST PASSED: " << g_progress.load()
+            << " handshakes with seq-cst and acquire/release park/wake orderings.\n";
+    return EXIT_SUCCESS;
+}
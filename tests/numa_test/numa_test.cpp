@@ -0,0 +1,146 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static constexpr int NUM_WAITERS = 8;
+
+/// Enough handles to span several arena chunks, so that chunk refills and slot reuse are exercised
+static constexpr int NUM_CHURN_HANDLES = 4096;
+
+/// Returns the node the memory at `address` actually resides on, or -1 if the kernel cannot tell.
+/// Asks the kernel directly, independently of what the library recorded for the handle.
+static int residentNode(const void *address) {
+#ifdef __linux__
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        // No NUMA support in the kernel, or the call is filtered (e.g. by a container's seccomp profile)
+        return -1;
+    }
+    return node;
+#else
+    (void) address;
+    return -1;
+#endif
+}
+
+/// Returns the node the handle's memory actually resides on, or -1 if unknown.
+static int residentNodeOfHandle(tpark_handle_t *handle) {
+    // Write the handle, so that its page is faulted in before asking where it lives
+    tparkBeginPark(handle);
+    tparkEndPark(handle);
+    return residentNode(handle);
+}
+
+/// Handles must live on the requested node, and every handle must report the node it actually lives on.
+static bool testPlacement() {
+    const int nodeCount = tparkNodeCount();
+    const int current = tparkCurrentNode();
+    if (nodeCount < 1 || current < 0 || current >= nodeCount) {
+        std::cerr << "Invalid node topology: " << nodeCount << " nodes, current node " << current << std::endl;
+        return false;
+    }
+
+    bool ok = true;
+    std::vector<tpark_handle_t *> handles;
+    handles.push_back(tparkCreateHandle());
+    handles.push_back(tparkCreateHandleOnNode(TPARK_NODE_ANY));
+    handles.push_back(tparkCreateHandleOnNode(TPARK_NODE_CURRENT));
+    for (int node = 0; node < nodeCount; node++) {
+        // Assumes the node has free memory; the arena only prefers the node and would spill over otherwise
+        tpark_handle_t *handle = tparkCreateHandleOnNode(node);
+        if (const int resident = residentNodeOfHandle(handle); resident >= 0 && resident != node) {
+            std::cerr << "Handle requested on node " << node << " resides on node " << resident << std::endl;
+            ok = false;
+        }
+        handles.push_back(handle);
+    }
+    for (tpark_handle_t *handle: handles) {
+        const int node = tparkHandleNode(handle);
+        if (node < 0 || node >= nodeCount) {
+            std::cerr << "Handle reports nonexistent node " << node << std::endl;
+            ok = false;
+        } else if (const int resident = residentNodeOfHandle(handle); resident >= 0 && resident != node) {
+            std::cerr << "Handle residing on node " << resident << " reports node " << node << std::endl;
+            ok = false;
+        }
+        tparkDestroyHandle(handle);
+    }
+    return ok;
+}
+
+/// Node-local handles must park and wake like any other, including when slots are recycled.
+static bool testChurn() {
+    std::vector<tpark_handle_t *> handles;
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < NUM_CHURN_HANDLES; i++) {
+            handles.push_back(tparkCreateHandleOnNode(TPARK_NODE_CURRENT));
+            if (tparkIsParked(handles.back())) {
+                std::cerr << "Freshly created handle is parked" << std::endl;
+                return false;
+            }
+            tparkBeginPark(handles.back());
+        }
+        for (tpark_handle_t *handle: handles) {
+            tparkWake(handle);
+            if (tparkIsParked(handle)) {
+                std::cerr << "Wake did not clear the park bit" << std::endl;
+                return false;
+            }
+            tparkDestroyHandle(handle);
+        }
+        handles.clear();
+    }
+    return true;
+}
+
+/// A grouped wake must wake every parked thread, whichever node its handle is on.
+static bool testWakeMany() {
+    const int nodeCount = tparkNodeCount();
+    std::vector<tpark_handle_t *> handles;
+    for (int i = 0; i < NUM_WAITERS; i++) {
+        // Spread the handles over all nodes, plus some without placement
+        handles.push_back(tparkCreateHandleOnNode(i % 3 == 2 ? TPARK_NODE_ANY : i % nodeCount));
+        tparkBeginPark(handles.back());
+    }
+
+    std::atomic numWoken{0};
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < NUM_WAITERS; i++) {
+        waiters.emplace_back([&, i] {
+            tparkWait(handles[i], true);
+            numWoken.fetch_add(1);
+        });
+    }
+    tparkWakeMany(handles.data(), handles.size());
+    for (std::thread &waiter: waiters) {
+        waiter.join();
+    }
+
+    for (const tpark_handle_t *handle: handles) {
+        tparkDestroyHandle(handle);
+    }
+    if (numWoken.load() != NUM_WAITERS) {
+        std::cerr << "Grouped wake woke " << numWoken.load() << " of " << NUM_WAITERS << " waiters" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    if (!testPlacement() || !testChurn() || !testWakeMany()) {
+        std::cerr << "TEST FAILED: NUMA-placed handles misbehaved.\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "TEST PASSED: NUMA-placed handles work on " << tparkNodeCount() << " node(s).\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+static constexpr int NUM_THREADS = 4;
+static constexpr int LOCKS_PER_THREAD = 10000;
+static constexpr auto TIMEOUT = std::chrono::milliseconds(50);
+
+/// How long the low-priority owner holds the mutex in the inversion scenario
+static constexpr auto HOLD_TIME = std::chrono::milliseconds(20);
+
+/// How long the medium-priority thread hogs the CPU in the inversion scenario
+static constexpr auto HOG_TIME = std::chrono::milliseconds(400);
+
+/// Maximum acceptable acquisition latency of the high-priority thread
+static constexpr auto MAX_ACQUIRE_LATENCY = std::chrono::milliseconds(200);
+
+/// Busy-waits (without yielding the CPU) for the given amount of wall-clock time
+static void spinFor(const std::chrono::steady_clock::duration duration) {
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+static bool testMutualExclusion() {
+    tpark_pi_mutex_t *mutex = tparkCreatePiMutex();
+    long long counter = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; i++) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < LOCKS_PER_THREAD; j++) {
+                tparkPiMutexLock(mutex);
+                counter++;
+                tparkPiMutexUnlock(mutex);
+            }
+        });
+    }
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    tparkDestroyPiMutex(mutex);
+
+    if (counter != NUM_THREADS * LOCKS_PER_THREAD) {
+        std::cerr << "Lost increments under the mutex: " << counter << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool testTryAndTimedLock() {
+    tpark_pi_mutex_t *mutex = tparkCreatePiMutex();
+    tparkPiMutexLock(mutex);
+
+    bool ok = true;
+    std::thread contender([&] {
+        if (tparkPiMutexTryLock(mutex)) {
+            std::cerr << "Try-lock succeeded on a held mutex" << std::endl;
+            ok = false;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        if (tparkPiMutexTimedLock(mutex, std::chrono::nanoseconds(TIMEOUT).count())) {
+            std::cerr << "Timed lock succeeded on a held mutex" << std::endl;
+            ok = false;
+        } else if (std::chrono::steady_clock::now() - start < TIMEOUT) {
+            std::cerr << "Timed lock timed out early" << std::endl;
+            ok = false;
+        }
+    });
+    contender.join();
+
+    // Once released, a timed lock from another thread succeeds
+    tparkPiMutexUnlock(mutex);
+    std::thread acquirer([&] {
+        if (!tparkPiMutexTimedLock(mutex, std::chrono::nanoseconds(TIMEOUT).count())) {
+            std::cerr << "Timed lock failed on a free mutex" << std::endl;
+            ok = false;
+            return;
+        }
+        tparkPiMutexUnlock(mutex);
+    });
+    acquirer.join();
+
+    tparkDestroyPiMutex(mutex);
+    return ok;
+}
+
+#ifdef __linux__
+static bool setFifoPriority(const int priority) {
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+#endif
+
+/// Classic priority inversion: a low-priority thread holds the mutex, a medium-priority thread hogs the CPU,
+/// and a high-priority thread wants the mutex. With priority inheritance the owner is boosted past the
+/// medium-priority thread, so the high-priority thread gets the mutex after about HOLD_TIME.
+/// Without SCHED_FIFO, no priorities are assigned and no hog is started.
+/// Returns the high-priority thread's acquisition latency.
+static std::chrono::steady_clock::duration measureInversionLatency(const bool realtime) {
+    tpark_pi_mutex_t *mutex = tparkCreatePiMutex();
+    std::atomic ownerHoldsLock{false};
+    std::chrono::steady_clock::duration latency{};
+
+    std::thread owner([&] {
+#ifdef __linux__
+        if (realtime) setFifoPriority(10);
+#endif
+        tparkPiMutexLock(mutex);
+        ownerHoldsLock.store(true);
+        spinFor(HOLD_TIME);
+        tparkPiMutexUnlock(mutex);
+    });
+    while (!ownerHoldsLock.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Started back to back; they only get to run once the orchestrating thread blocks in join()
+    std::thread hog;
+    if (realtime) {
+        hog = std::thread([] {
+#ifdef __linux__
+            setFifoPriority(20);
+#endif
+            spinFor(HOG_TIME);
+        });
+    }
+    std::thread waiter([&] {
+#ifdef __linux__
+        if (realtime) setFifoPriority(30);
+#endif
+        const auto start = std::chrono::steady_clock::now();
+        tparkPiMutexLock(mutex);
+        latency = std::chrono::steady_clock::now() - start;
+        tparkPiMutexUnlock(mutex);
+    });
+
+    waiter.join();
+    owner.join();
+    if (hog.joinable()) {
+        hog.join();
+    }
+    tparkDestroyPiMutex(mutex);
+    return latency;
+}
+
+int main() {
+    if (!testMutualExclusion() || !testTryAndTimedLock()) {
+        std::cerr << "TEST FAILED: Mutex semantics violated.\n";
+        return EXIT_FAILURE;
+    }
+
+    // Run all inversion threads on one CPU at real-time priority, orchestrated from the highest priority
+    bool realtime = false;
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(sched_getcpu(), &cpus);
+    realtime = sched_setaffinity(0, sizeof(cpus), &cpus) == 0 && setFifoPriority(40);
+#endif
+    if (!realtime) {
+        std::cout << "SCHED_FIFO unavailable (missing CAP_SYS_NICE or not on Linux); "
+                "measuring acquisition latency without competing real-time threads.\n";
+    }
+
+    const auto latency = measureInversionLatency(realtime);
+    const auto latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+    if (latency > MAX_ACQUIRE_LATENCY) {
+        std::cerr << "TEST FAILED: High-priority thread waited " << latencyMs
+                << " ms for the mutex. Priority inversion was not bounded.\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "TEST PASSED: High-priority thread acquired the mutex after " << latencyMs << " ms"
+            << (realtime ? " under SCHED_FIFO inversion.\n" : ".\n");
+    return EXIT_SUCCESS;
+}
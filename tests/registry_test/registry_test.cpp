@@ -0,0 +1,101 @@
+#include <threadpark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static constexpr uint64_t STALL_THRESHOLD_MS = 100;
+static constexpr uint64_t WATCHDOG_INTERVAL_MS = 20;
+
+/// Exit code reporting the test as skipped to CTest (SKIP_RETURN_CODE)
+static constexpr int EXIT_SKIPPED = 77;
+
+static std::atomic g_stallReports{0};
+static std::atomic<const tpark_handle_t *> g_stalledHandle{nullptr};
+
+static const tpark_handle_info_t *findInfo(const std::vector<tpark_handle_info_t> &infos,
+                                           const tpark_handle_t *handle) {
+    for (const tpark_handle_info_t &info: infos) {
+        if (info.handle == handle) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+static std::vector<tpark_handle_info_t> takeSnapshot() {
+    std::vector<tpark_handle_info_t> infos(tparkRegistrySnapshot(nullptr, 0));
+    infos.resize(std::min(infos.size(), tparkRegistrySnapshot(infos.data(), infos.size())));
+    return infos;
+}
+
+int main() {
+    if (!tparkRegistryEnabled()) {
+        std::cout << "TEST SKIPPED: Registry not compiled in (THREAD_PARK_ENABLE_REGISTRY=OFF).\n";
+        return EXIT_SKIPPED;
+    }
+
+    tpark_handle_t *idleHandle = tparkCreateHandle();
+    tpark_handle_t *stuckHandle = tparkCreateHandle();
+    tparkSetHandleName(idleHandle, "idle");
+    tparkSetHandleName(stuckHandle, "stuck-worker");
+
+    // Every live handle is listed, with its name
+    std::vector<tpark_handle_info_t> infos = takeSnapshot();
+    const tpark_handle_info_t *idleInfo = findInfo(infos, idleHandle);
+    if (infos.size() != 2 || idleInfo == nullptr || std::strcmp(idleInfo->name, "idle") != 0 || idleInfo->parked) {
+        std::cerr << "TEST FAILED: Snapshot does not describe the live handles.\n";
+        return EXIT_FAILURE;
+    }
+
+    if (!tparkStartWatchdog(STALL_THRESHOLD_MS, WATCHDOG_INTERVAL_MS, [](const tpark_handle_info_t *info, void *) {
+        g_stalledHandle.store(info->handle);
+        g_stallReports.fetch_add(1);
+    }, nullptr)) {
+        std::cerr << "TEST FAILED: Watchdog did not start.\n";
+        return EXIT_FAILURE;
+    }
+
+    std::thread parker([&] { tparkWait(stuckHandle, false); });
+
+    // The watchdog must report the stall exactly once per park episode
+    std::this_thread::sleep_for(std::chrono::milliseconds(STALL_THRESHOLD_MS * 4));
+    infos = takeSnapshot();
+    const tpark_handle_info_t *stuckInfo = findInfo(infos, stuckHandle);
+    if (stuckInfo == nullptr || !stuckInfo->parked ||
+        stuckInfo->snapshot_ns - stuckInfo->park_start_ns < STALL_THRESHOLD_MS * 1000000) {
+        std::cerr << "TEST FAILED: Snapshot does not show the parked handle.\n";
+        return EXIT_FAILURE;
+    }
+    if (g_stallReports.load() != 1 || g_stalledHandle.load() != stuckHandle) {
+        std::cerr << "TEST FAILED: Expected exactly one stall report, got " << g_stallReports.load() << ".\n";
+        return EXIT_FAILURE;
+    }
+
+    tparkWake(stuckHandle);
+    parker.join();
+    tparkStopWatchdog();
+
+    infos = takeSnapshot();
+    stuckInfo = findInfo(infos, stuckHandle);
+    if (stuckInfo == nullptr || stuckInfo->parked || stuckInfo->last_wake_ns == 0 ||
+        stuckInfo->last_waker_thread_id == 0) {
+        std::cerr << "TEST FAILED: Snapshot does not record the wake.\n";
+        return EXIT_FAILURE;
+    }
+
+    tparkDestroyHandle(idleHandle);
+    tparkDestroyHandle(stuckHandle);
+    if (tparkRegistrySnapshot(nullptr, 0) != 0) {
+        std::cerr << "TEST FAILED: Destroyed handles are still registered.\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "TEST PASSED: Registry tracked handles and the watchdog reported the stall.\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static constexpr int NUM_READERS = 8;
+static constexpr int NUM_WRITERS = 2;
+static constexpr int WRITES_PER_WRITER = 250;
+
+/// Protected by the lock. Writers keep both values equal; readers must never observe them differ.
+static long long g_valueA = 0;
+static long long g_valueB = 0;
+
+static std::atomic g_activeWriters{0};
+static std::atomic g_activeReaders{0};
+static std::atomic g_testFailed{false};
+
+int main() {
+    tpark_rwlock_t *lock = tparkCreateRwLock();
+    std::atomic g_writersDone{false};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < NUM_READERS; i++) {
+        readers.emplace_back([&] {
+            while (!g_writersDone.load() && !g_testFailed.load()) {
+                tparkRwLockReadLock(lock);
+                g_activeReaders.fetch_add(1);
+                if (g_activeWriters.load() != 0 || g_valueA != g_valueB) {
+                    std::cerr << "Reader observed a writer inside the critical section" << std::endl;
+                    g_testFailed.store(true);
+                }
+                g_activeReaders.fetch_sub(1);
+                tparkRwLockReadUnlock(lock);
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int i = 0; i < NUM_WRITERS; i++) {
+        writers.emplace_back([&] {
+            for (int j = 0; j < WRITES_PER_WRITER && !g_testFailed.load(); j++) {
+                tparkRwLockWriteLock(lock);
+                if (g_activeWriters.fetch_add(1) != 0 || g_activeReaders.load() != 0) {
+                    std::cerr << "Writer shares the critical section with another thread" << std::endl;
+                    g_testFailed.store(true);
+                }
+                g_valueA++;
+                std::this_thread::yield();
+                g_valueB++;
+                g_activeWriters.fetch_sub(1);
+                tparkRwLockWriteUnlock(lock);
+            }
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::thread &writer: writers) {
+        writer.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    g_writersDone.store(true);
+    for (std::thread &reader: readers) {
+        reader.join();
+    }
+
+    tparkDestroyRwLock(lock);
+
+    if (g_testFailed.load()) {
+        std::cerr << "TEST FAILED: Reader-writer lock exclusion violated.\n";
+        return EXIT_FAILURE;
+    }
+    if (g_valueA != NUM_WRITERS * WRITES_PER_WRITER || g_valueA != g_valueB) {
+        std::cerr << "TEST FAILED: Lost writes (" << g_valueA << ", " << g_valueB << ").\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "TEST PASSED: " << NUM_WRITERS * WRITES_PER_WRITER << " writes alongside " << NUM_READERS
+            << " readers in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.\n";
+    return EXIT_SUCCESS;
+}
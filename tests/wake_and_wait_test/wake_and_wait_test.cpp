@@ -0,0 +1,57 @@
+#include <threadpark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/// As many as ping_pong_benchmark, so that rare stale wakes from a previous round are actually hit
+static constexpr int NUM_ROUND_TRIPS = 200000;
+
+/// Incremented by whichever side currently holds the "ball"; odd => ponger's turn, even => pinger's turn.
+static std::atomic g_turn{0};
+static std::atomic g_testFailed{false};
+
+int main() {
+    tpark_handle_t *pingHandle = tparkCreateHandle();
+    tpark_handle_t *pongHandle = tparkCreateHandle();
+
+    // The ponger must be armed before the pinger can wake it for the first time
+    tparkBeginPark(pongHandle);
+
+    std::thread ponger([&] {
+        tparkWait(pongHandle, true);
+        for (int i = 0; i < NUM_ROUND_TRIPS; i++) {
+            if (g_turn.fetch_add(1) != 2 * i + 1) {
+                g_testFailed.store(true);
+            }
+            if (i + 1 == NUM_ROUND_TRIPS) {
+                tparkWake(pingHandle);
+            } else {
+                tparkWakeAndWait(pingHandle, pongHandle, false);
+            }
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_ROUND_TRIPS; i++) {
+        if (g_turn.fetch_add(1) != 2 * i) {
+            g_testFailed.store(true);
+        }
+        tparkWakeAndWait(pongHandle, pingHandle, false);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    ponger.join();
+    tparkDestroyHandle(pingHandle);
+    tparkDestroyHandle(pongHandle);
+
+    if (g_testFailed.load() || g_turn.load() != 2 * NUM_ROUND_TRIPS) {
+        std::cerr << "TEST FAILED: Ping-pong turns were interleaved incorrectly.\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "TEST PASSED: " << NUM_ROUND_TRIPS << " round trips in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.\n";
+    return EXIT_SUCCESS;
+}
@@ -1,4 +1,8 @@
 #include "threadpark.h"
+#include "threadpark_cancel.h"
+#include "threadpark_internal.h"
+#include "threadpark_numa.h"
+#include "threadpark_registry.h"
 
 #include <atomic>
 #include <iostream>
@@ -11,14 +15,31 @@ struct tpark_handle_t {
     ///  - 1 indicates "parked"
     ///  - 0 indicates "not parked"
     std::atomic<ULONG> state{0};
+
+    /// Cancellation token the handle is associated with, if any
+    tpark_cancel_link_t cancel;
+
+    /// NUMA node and origin of the handle's memory
+    tpark_numa_placement_t numa;
+
+    TPARK_REGISTRY_ENTRY
 };
 
-tpark_handle_t *tparkCreateHandle() {
-    return new tpark_handle_t();
+tpark_cancel_link_t *tpark_cancel_link(tpark_handle_t *handle) { return &handle->cancel; }
+
+TPARK_REGISTRY_ENTRY_ACCESSOR
+
+tpark_handle_t *tparkCreateHandle() { return tparkCreateHandleOnNode(TPARK_NODE_ANY); }
+
+tpark_handle_t *tparkCreateHandleOnNode(const int node) {
+    auto *handle = tpark_numa_new<tpark_handle_t>(node);
+    TPARK_REGISTRY_ADD(handle);
+    return handle;
 }
 
-void tparkWait(tpark_handle_t *handle, const bool unlocked) {
+tpark_wait_result_t tparkWait(tpark_handle_t *handle, const bool unlocked) {
     if (!unlocked) {
+        TPARK_REGISTRY_ON_PARK(handle);
         // Indicate we want to park
         handle->state.store(1, std::memory_order_seq_cst);
     }
@@ -26,7 +47,12 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
     // Wait until 'state' changes from 1 to something else.
     // If the call fails or returns (e.g. spurious wake), we re-check the state.
     ULONG expected = 1;
-    while (handle->state.load(std::memory_order_seq_cst) == expected) {
+    while (handle->state.load(std::memory_order_acquire) == expected) {
+        // Checked after setting the park bit, so that a concurrent tparkCancel either sees us parked or is seen here
+        if (tpark_cancel_requested(&handle->cancel)) {
+            tparkEndPark(handle);
+            return TPARK_WAIT_CANCELLED;
+        }
         const BOOL success = WaitOnAddress(
             /* Address        = */ &handle->state,
             /* CompareAddress = */ &expected,
@@ -44,29 +70,76 @@ void tparkWait(tpark_handle_t *handle, const bool unlocked) {
             }
         }
     }
+    return tpark_cancel_wait_result(&handle->cancel);
+}
+
+void tparkBeginPark(tpark_handle_t *handle) { tparkBeginParkExplicit(handle, TPARK_ORDER_SEQ_CST); }
+
+void tparkBeginParkExplicit(tpark_handle_t *handle, const tpark_memory_order_t order) {
+    TPARK_REGISTRY_ON_PARK(handle);
+    handle->state.store(1, tpark_park_order(order));
 }
 
-void tparkBeginPark(tpark_handle_t *handle) { handle->state.store(1, std::memory_order_seq_cst); }
+void tparkEndPark(tpark_handle_t *handle) {
+    // Relaxed: a waker that observes 0 merely skips a wake this thread no longer waits for.
+    // The next tparkBeginPark re-establishes the ordering needed to park again.
+    handle->state.store(0, std::memory_order_relaxed);
+}
 
-void tparkEndPark(tpark_handle_t *handle) { handle->state.store(0, std::memory_order_seq_cst); }
+void tparkWake(tpark_handle_t *handle) { tparkWakeExplicit(handle, TPARK_ORDER_SEQ_CST); }
 
-void tparkWake(tpark_handle_t *handle) {
-    if (handle->state.load(std::memory_order_seq_cst) == 0) {
+void tparkWakeExplicit(tpark_handle_t *handle, const tpark_memory_order_t order) {
+    if (handle->state.load(tpark_wake_check_order(order)) == 0) {
         // No need to wake up, the thread is not parked
         return;
     }
+    TPARK_REGISTRY_ON_WAKE(handle);
 
     // Set the state to 0, signaling that any parked thread should wake.
-    handle->state.store(0, std::memory_order_seq_cst);
+    // Release, so that the woken thread observes everything we wrote before waking it.
+    handle->state.store(0, std::memory_order_release);
 
     // Wake exactly one waiter waiting on &handle->state with the compare-value=1
     WakeByAddressSingle(&handle->state);
 }
 
 bool tparkIsParked(const tpark_handle_t *handle) {
-    return handle->state.load(std::memory_order_seq_cst) == 1;
+    return handle->state.load(std::memory_order_acquire) == 1;
+}
+
+void *tpark_park_word(tpark_handle_t *handle) { return &handle->state; }
+
+bool tpark_abandon_park(tpark_handle_t *handle) {
+    ULONG expected = 1;
+    return handle->state.compare_exchange_strong(expected, 0, std::memory_order_acquire);
 }
 
 void tparkDestroyHandle(const tpark_handle_t *handle) {
-    delete handle;
+    tpark_cancel_detach(&handle->cancel, handle);
+    TPARK_REGISTRY_REMOVE(handle);
+    tpark_numa_delete(handle);
+}
+
+int tparkHandleNode(const tpark_handle_t *handle) { return tpark_numa_handle_node(handle); }
+
+tpark_wait_result_t tparkWaitOnAddress(void *addr, uint32_t expected, const uint64_t timeout_ns) {
+    DWORD timeout_ms = INFINITE;
+    if (timeout_ns != TPARK_INFINITE) {
+        // Round up, so that we never time out before the requested time has passed
+        const uint64_t ms = timeout_ns / 1000000 + (timeout_ns % 1000000 != 0 ? 1 : 0);
+        timeout_ms = ms < INFINITE ? static_cast<DWORD>(ms) : INFINITE - 1;
+    }
+    if (!WaitOnAddress(addr, &expected, sizeof(expected), timeout_ms) && GetLastError() == ERROR_TIMEOUT) {
+        return TPARK_WAIT_TIMED_OUT;
+    }
+    return TPARK_WAIT_WOKEN;
+}
+
+void tparkWakeAddress(void *addr, const uint32_t count) {
+    // WaitOnAddress can only wake one or all waiters
+    if (count == 1) {
+        WakeByAddressSingle(addr);
+    } else if (count > 1) {
+        WakeByAddressAll(addr);
+    }
 }